@@ -15,6 +15,7 @@ include rs232.asm
 include rtc.asm
 include speaker.asm
 include fs.asm
+include perf.asm
 include string.asm
 
 ; BIOS version
@@ -95,8 +96,7 @@ const loadingErrorTooBigText "Error: The OS file is too large"
 ; No return
 .printBiosVersion:
 	gp *biosVersionText
-	call .xStringPrint
-	call .xLcdRefresh
+	call .xLcdPrintString
 	call .xLcdNewLine
 	ret
 
@@ -161,8 +161,7 @@ const loadingErrorTooBigText "Error: The OS file is too large"
 	enter
 	alloc 3
 	gp *loadingSearchText
-	call .xStringPrint
-	call .xLcdRefresh
+	call .xLcdPrintString
 	call .xLcdNewLine
 .loadOs_openFile:
 	call .xFsOpenOs
@@ -187,8 +186,7 @@ const loadingErrorTooBigText "Error: The OS file is too large"
 	stf X, 32
 	stf Y, 33
 	gp *loadingStartText
-	call .xStringPrint
-	call .xLcdRefresh
+	call .xLcdPrintString
 	; save dest address on stack
 	mov 0x08, A
 	stf A, 34
@@ -205,11 +203,7 @@ const loadingErrorTooBigText "Error: The OS file is too large"
 .loadOs_loadFileCopyDataLoopInit:
 	ldf 34, Y
 	clr X
-.loadOs_loadFileCopyDataLoop:
-	call .xFSGetNextDataByte
-	stp A
-	incp
-	loopz B, .loadOs_loadFileCopyDataLoop
+	call .xFsLoadBlock
 	stf Y, 34
 	mov '.', A
 	call .xLcdPrintChar
@@ -219,8 +213,7 @@ const loadingErrorTooBigText "Error: The OS file is too large"
 .loadOs_done:
 	call .xLcdNewLine
 	gp *loadingDoneText
-	call .xStringPrint
-	call .xLcdRefresh
+	call .xLcdPrintString
 	call .xLcdNewLine
 	call .xLcdNewLine
 	leave
@@ -229,20 +222,17 @@ const loadingErrorTooBigText "Error: The OS file is too large"
 ; Show no file found error message
 .loadOs_errorNoFile:
 	gp *loadingErrorNoFileText
-	call .xStringPrint
-	call .xLcdRefresh
+	call .xLcdPrintString
 	halt
 
 ; Show empty file error message
 .loadOs_errorEmpty:
 	gp *loadingErrorEmptyText
-	call .xStringPrint
-	call .xLcdRefresh
+	call .xLcdPrintString
 	halt
 
 ; Show too large file error message
 .loadOs_errorTooLarge:
 	gp *loadingErrorTooBigText
-	call .xStringPrint
-	call .xLcdRefresh
+	call .xLcdPrintString
 	halt
@@ -141,3 +141,144 @@ external .xFSGetNextDataByte:
 	call .xIOSetRegister
 	call .xIORead
 	ret
+
+; No arguments
+; No return
+external .xFsOpenStream:
+	push A
+	; Set command register
+	clr A
+	call .xIOSetRegister
+	mov 0x8, A
+	; Write open stream command
+	call .xIOWriteLowHalf
+	pop A
+	ret
+
+; Arguments:
+; 	A - high byte of offset
+; 	Y - middle byte of offset
+; 	X - low byte of offset
+; Return:
+; 	A - status (0 - seek failed, 1 - ready to read)
+external .xFsSeek:
+	push B
+	; Write high byte of offset
+	mov 0x2, B
+	call .xFsSeekField
+	; Write middle byte of offset
+	mov Y, A
+	mov 0x1, B
+	call .xFsSeekField
+	; Write low byte of offset
+	mov X, A
+	clr B
+	call .xFsSeekField
+	pop B
+	; Set command register
+	clr A
+	call .xIOSetRegister
+	mov 0x7, A
+	; Write seek command
+	call .xIOWriteLowHalf
+	jmp .xFsGetStatus
+
+; Arguments:
+; 	A - byte of offset
+; 	B - field address of byte
+; No return
+global .xFsSeekField:
+	push A
+	mov 0x2, A
+	call .xIOSetRegister
+	mov B, A
+	call .xIOWriteLowHalf
+	mov 0x3, A
+	call .xIOSetRegister
+	pop A
+	call .xIOWrite
+	ret
+
+; No arguments
+; Return:
+; 	A - extended byte of data size, bits 16-23
+external .xFsGetSizeExt:
+	mov 0x2, A
+	call .xIOSetRegister
+	mov 0x3, A
+	call .xIOWriteLowHalf
+	call .xIOSetRegister
+	call .xIORead
+	ret
+
+; Load bytes of the open file to memory. The IO board reads the block ahead,
+; so bytes are read with only two half reads each and without selecting the register again.
+; Arguments:
+; 	B - quantity of bytes to load minus one
+; 	P - destination address
+; Return:
+; 	P - address after the last loaded byte
+external .xFsLoadBlock:
+	enter
+	alloc 1
+	push A
+	push B
+	; Set command register
+	clr A
+	call .xIOSetRegister
+	mov 0x9, A
+	; Write read block command
+	call .xIOWriteLowHalf
+	; Set data register
+	mov 0xA, A
+	call .xIOSetRegister
+.xFsLoadBlock_loop:
+	stf B, 32
+	; Get bus status bit
+	in B
+	and 0x80, B
+	; Read low half
+	out 0x00
+	out 0b10100000
+.xFsLoadBlock_waitLow:
+	in A
+	and 0x80, A
+	cmp A, B
+	je .xFsLoadBlock_waitLow
+	mov A, B
+	; Keep low half in memory
+	in A
+	and 0x0f, A
+	stp A
+	; Read high half
+	out 0x00
+	out 0b10110000
+.xFsLoadBlock_waitHigh:
+	in A
+	and 0x80, A
+	cmp A, B
+	je .xFsLoadBlock_waitHigh
+	; Join both halves
+	in A
+	swap A
+	and 0xf0, A
+	ldp B
+	or B, A
+	stp A
+	incp
+	ldf 32, B
+	loopz B, .xFsLoadBlock_loop
+	pop B
+	pop A
+	leave
+	ret
+
+; Select the data register for the streaming mode, next data bytes are read with .xIOStreamRead
+; No arguments
+; No return
+external .xFsStreamBegin:
+	push A
+	mov 0xA, A
+	call .xIOSetRegister
+	pop A
+	ret
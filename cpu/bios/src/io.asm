@@ -188,3 +188,83 @@ global .xIORead:
 	call .xIOReadLowHalf
 	call .xIOReadHighHalf
 	ret
+
+; Read the next byte of the selected register in the streaming mode.
+; The register stays selected, so only two half reads are needed for every byte.
+; No arguments
+; Return:
+; 	A - received data
+external .xIOStreamRead:
+	push X
+	push B
+	; Get bus status bit
+	in X
+	and 0x80, X
+	; Read low half
+	out 0x00
+	out 0b10100000
+.xIOStreamRead_waitLow:
+	in A
+	and 0x80, A
+	cmp A, X
+	je .xIOStreamRead_waitLow
+	mov A, X
+	in B
+	and 0x0f, B
+	; Read high half
+	out 0x00
+	out 0b10110000
+.xIOStreamRead_waitHigh:
+	in A
+	and 0x80, A
+	cmp A, X
+	je .xIOStreamRead_waitHigh
+	; Join both halves
+	in A
+	swap A
+	and 0xf0, A
+	or B, A
+	pop B
+	pop X
+	ret
+
+; Write the next byte to the selected register in the streaming mode.
+; The register stays selected, so only two half writes are needed for every byte.
+; Arguments:
+; 	A - data to transmit
+; No return
+external .xIOStreamWrite:
+	push X
+	push B
+	push A
+	mov A, B
+	; Get bus status bit
+	in X
+	and 0x80, X
+	; Send low half
+	out 0x00
+	and 0x0f, A
+	or 0b11100000, A
+	out A
+.xIOStreamWrite_waitLow:
+	in A
+	and 0x80, A
+	cmp A, X
+	je .xIOStreamWrite_waitLow
+	mov A, X
+	; Send high half
+	out 0x00
+	mov B, A
+	swap A
+	and 0x0f, A
+	or 0b11110000, A
+	out A
+.xIOStreamWrite_waitHigh:
+	in A
+	and 0x80, A
+	cmp A, X
+	je .xIOStreamWrite_waitHigh
+	pop A
+	pop B
+	pop X
+	ret
@@ -164,3 +164,36 @@ external .xLcdPrintChar:
 	; Write char
 	call .xIOWrite
 	ret
+
+; Select the lcd char register for the streaming mode, next chars are written with .xIOStreamWrite
+; No arguments
+; No return
+external .xLcdStreamBegin:
+	push A
+	mov 0x8, A
+	call .xIOSetRegister
+	pop A
+	ret
+
+; Print a string and refresh the screen once. Chars are buffered by the lcd string register until zero is written.
+; Arguments:
+; 	P - address of a string ending with zero
+; No return
+external .xLcdPrintString:
+	push X
+	push Y
+	push A
+	; Set lcd string register
+	mov 0xB, A
+	call .xIOSetRegister
+.xLcdPrintString_loop:
+	; Write char, zero prints the string
+	ldp A
+	call .xIOStreamWrite
+	incp
+	cmp 0, A
+	jne .xLcdPrintString_loop
+	pop A
+	pop Y
+	pop X
+	ret
@@ -0,0 +1,45 @@
+; Author: Pawel Jablonski
+; E-mail: pj@xirx.net
+; WWW: xirx.net
+; GIT: git.xirx.net
+;
+; License: You can use this code however you like
+; but leave information about the original author.
+; Code is free for non-commercial and commercial use.
+
+include io.asm
+
+; Arguments:
+; 	X - low address of 8 bytes buffer
+;	Y - high address of 8 bytes buffer
+; Return:
+; 	Buffer - ticks (4 bytes) and executed instructions (4 bytes), both little-endian
+external .xPerfGetCounters:
+	push X
+	push Y
+	push A
+	push B
+	; Set command register
+	clr A
+	call .xIOSetRegister
+	; Write latch counters command
+	mov 0x6, A
+	call .xIOWriteLowHalf
+	; Select counters field
+	mov 0x2, A
+	call .xIOSetRegister
+	call .xIOWriteLowHalf
+	mov 0x3, A
+	call .xIOSetRegister
+	; Copy 8 bytes of counters to the buffer
+	mov 7, B
+.xPerfGetCounters_loop:
+	call .xIORead
+	stp A
+	incp
+	loopz B, .xPerfGetCounters_loop
+	pop B
+	pop A
+	pop Y
+	pop X
+	ret
@@ -50,3 +50,13 @@ external .xRS232IsRxDataReady:
 .xRS232IsRxDataReady_ready:
 	mov 1, A
 	ret
+
+; Select the rs232 register for the streaming mode, next bytes are sent with .xIOStreamWrite or received with .xIOStreamRead
+; No arguments
+; No return
+external .xRS232StreamBegin:
+	push A
+	mov 0x9, A
+	call .xIOSetRegister
+	pop A
+	ret
@@ -50,6 +50,14 @@ static unsigned int dataLength = 0; //!< Length of data
 static int readBlockType = FS_READ_BLOCK_UNKNOWN; //!< Type of reading block
 static unsigned char dirBuffer[FS_DIR_ENTRY_SIZE * FS_DIR_MAX_QUANTITY]; //!< Directory entrys buffer
 
+static unsigned char blockBuffer[FS_BLOCK_SIZE]; //!< Block of the file read ahead
+static unsigned int blockStart = 0; //!< Position of the first byte of the read ahead block in the file
+static unsigned int blockLength = 0; //!< Length of the read ahead block
+
+static unsigned char prefetchData = 0; //!< Next byte of the file fetched before it is read
+static unsigned int prefetchPos = 0; //!< Position of the prefetched byte in the file
+static bool prefetchValid = FALSE; //!< Status of the prefetched byte
+
 //! Init file system and set up the FAT
 void fsInit(void)
 {
@@ -64,15 +72,19 @@ void fsInit(void)
  *
  * @param path Path to the file
  * @param size Struct to store a size of the file
+ * @param maxSize Maximum size of the file
  *
  * @return Status of open operation
  */
-bool fsOpen(const char *path, struct FSSize *size)
+bool fsOpen(const char *path, struct FSSize *size, unsigned int maxSize)
 {
 	size->low = 0;
 	size->high = 0;
+	size->ext = 0;
 	
 	readBlockType = FS_READ_BLOCK_FILE;
+	blockLength = 0;
+	prefetchValid = FALSE;
 	
 	if(!fatMountStatus)
 	{
@@ -87,7 +99,7 @@ bool fsOpen(const char *path, struct FSSize *size)
 		{
 			DWORD fileSize = f_size(&fatFile);
 			
-			if(fileSize > FS_FILE_MAX_SIZE)
+			if(fileSize > maxSize)
 			{
 				f_close(&fatFile);
 
@@ -99,6 +111,7 @@ bool fsOpen(const char *path, struct FSSize *size)
 			
 			size->low = (fileSize % 256);
 			size->high = ((fileSize / 256) & 0xff);
+			size->ext = ((fileSize / 65536) & 0xff);
 			
 			return(TRUE);
 		}
@@ -119,8 +132,10 @@ bool fsList(const char *path, struct FSSize *size)
 {
 	size->low = 0;
 	size->high = 0;
+	size->ext = 0;
 	
 	readBlockType = FS_READ_BLOCK_DIR;
+	prefetchValid = FALSE;
 	
 	if(!fatMountStatus)
 	{
@@ -179,6 +194,88 @@ bool fsList(const char *path, struct FSSize *size)
 	return(FALSE);
 }
 
+/**
+ * Set the read position of the open file or list
+ *
+ * @param offset Offset from the beginning of the data
+ *
+ * @return Status of seek operation, it fails when the offset is beyond the end of the data
+ */
+bool fsSeek(unsigned int offset)
+{
+	if(offset > dataLength)
+	{
+		return(FALSE);
+	}
+	
+	dataPos = offset;
+	
+	return(TRUE);
+}
+
+/**
+ * Read the next block of the open file from the current position to the memory.
+ * Next bytes are read from the memory instead of the file until the end of the block.
+ *
+ * @return Status of read operation
+ */
+bool fsReadBlock(void)
+{
+	blockLength = 0;
+	
+	if((fatMountStatus) || (fatOpenStatus) || (readBlockType != FS_READ_BLOCK_FILE))
+	{
+		return(FALSE);
+	}
+	
+	if(f_lseek(&fatFile, dataPos))
+	{
+		return(FALSE);
+	}
+	
+	UINT read;
+	
+	if(f_read(&fatFile, blockBuffer, FS_BLOCK_SIZE, &read))
+	{
+		return(FALSE);
+	}
+	
+	blockStart = dataPos;
+	blockLength = read;
+	
+	return(TRUE);
+}
+
+/**
+ * Fetch the next byte of the open file without moving the read position.
+ * It is called after a byte is streamed to the CPU, so the next read does not wait for the card.
+ */
+void fsPrefetch(void)
+{
+	if((fatMountStatus) || (fatOpenStatus) || (readBlockType != FS_READ_BLOCK_FILE) || (dataPos >= dataLength))
+	{
+		return;
+	}
+	
+	if(((dataPos >= blockStart) && (dataPos < (blockStart + blockLength))) || ((prefetchValid) && (prefetchPos == dataPos)))
+	{
+		return;
+	}
+	
+	prefetchValid = FALSE;
+	
+	if(!f_lseek(&fatFile, dataPos))
+	{
+		UINT read;
+		
+		if((!f_read(&fatFile, &prefetchData, 1, &read)) && (read == 1))
+		{
+			prefetchPos = dataPos;
+			prefetchValid = TRUE;
+		}
+	}
+}
+
 /**
  * Read next byte of the data
  *
@@ -192,7 +289,15 @@ unsigned char fsReadNextDataByte(void)
 	{
 		if(dataPos < dataLength)
 		{
-			if(readBlockType == FS_READ_BLOCK_FILE)
+			if((readBlockType == FS_READ_BLOCK_FILE) && (dataPos >= blockStart) && (dataPos < (blockStart + blockLength)))
+			{
+				data = blockBuffer[dataPos - blockStart];
+			}
+			else if((readBlockType == FS_READ_BLOCK_FILE) && (prefetchValid) && (prefetchPos == dataPos))
+			{
+				data = prefetchData;
+			}
+			else if(readBlockType == FS_READ_BLOCK_FILE)
 			{
 				if(!f_lseek(&fatFile, dataPos))
 				{
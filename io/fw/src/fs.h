@@ -24,6 +24,7 @@
 #define FS_DIR_MAX_QUANTITY 64 //!< Maximum quantity of files in directory
 
 #define FS_FILE_MAX_SIZE 53248 //!< Maximum size of the file
+#define FS_STREAM_MAX_SIZE 0xffffff //!< Maximum size of the file opened as a stream, it is read in parts with seeking
 
 #define FS_MIN_CODE 0x20 //!< Minimum correctly character code
 #define FS_MAX_CODE 0x7e //!< Maximum correctly character code
@@ -33,12 +34,16 @@ struct FSSize
 {
 	unsigned char low; //!< Lower byte of the size
 	unsigned char high; //!< Higher byte of the size
+	unsigned char ext; //!< Extended byte of the size, bits 16-23
 };
 
 void fsInit(void);
 
-bool fsOpen(const char *path, struct FSSize *size);
+bool fsOpen(const char *path, struct FSSize *size, unsigned int maxSize);
 bool fsList(const char *path, struct FSSize *size);
+bool fsSeek(unsigned int offset);
+bool fsReadBlock(void);
+void fsPrefetch(void);
 
 unsigned char fsReadNextDataByte(void);
 
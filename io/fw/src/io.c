@@ -35,6 +35,9 @@
 #define RW_READ FALSE //!< Read data mode
 #define RW_WRITE TRUE //!< Write data mode
 
+#define PERF_COUNTER_SIZE 4 //!< Size in bytes of a single latched performance counter
+#define FS_OFFSET_SIZE 3 //!< Size in bytes of the seek offset
+
 //! Register addresses
 enum RegAddress
 {
@@ -48,7 +51,8 @@ enum RegAddress
 	REG_LCD_CURSOR_POS_Y = 7, //!< LCD cursor vertical position register
 	REG_LCD_CHAR = 8, //!< LCD char register
 	REG_RS232 = 9, //!< RS232 register
-	REG_FS = 10 //!< File System register
+	REG_FS = 10, //!< File System register
+	REG_LCD_STRING = 11 //!< LCD string register, chars are buffered and printed with one refresh when zero is written
 };
 
 //! Low part commands
@@ -59,7 +63,11 @@ enum CommandLow
 	FS_OPEN_APP = 2, //!< Open an application command
 	FS_OPEN_FILE = 3, //!< Open a file command
 	FS_LIST_APP = 4, //!< List files in the app directory
-	FS_LIST_FILE = 5 //!< List files in the file sirectory
+	FS_LIST_FILE = 5, //!< List files in the file sirectory
+	PERF_LATCH = 6, //!< Latch the tick and the instruction counters
+	FS_SEEK = 7, //!< Set the read position of the open file to the offset fields
+	FS_OPEN_STREAM = 8, //!< Open a file larger than the maximum file size, it is read in parts with seeking
+	FS_READ_BLOCK = 9 //!< Read the next block of the open file ahead, so its bytes are returned without waiting for the card
 };
 
 //! High part commands
@@ -110,6 +118,9 @@ enum FieldRW
 //! Writable fields
 enum FieldW
 {
+	FS_OFFSET_LOW = 0, //!< Low byte of the seek offset field
+	FS_OFFSET_MIDDLE = 1, //!< Middle byte of the seek offset field
+	FS_OFFSET_HIGH = 2, //!< High byte of the seek offset field
 	SPEAKER_NOTE = 12, //!< Code of a note to play field
 	SPEAKER_TIME = 13, //!< Play time of a note field
 	SPEAKER_FILL = 14, //!< Square fill of a note field
@@ -121,6 +132,8 @@ enum FieldR
 {
 	FS_DATA_SIZE_LOW = 0, //!< Low byte of a file size field
 	FS_DATA_SIZE_HIGH = 1, //!< High byte of a file size field
+	PERF_COUNTER = 2, //!< Next byte of the latched counters field. Four bytes of ticks and four bytes of instructions, both little-endian.
+	FS_DATA_SIZE_EXT = 3, //!< Extended byte of a file size field, bits 16-23
 	SPEAKER_BUFFER_FREE = 12 //!< Free space size in the sound buffer field
 };
 
@@ -142,12 +155,24 @@ struct
 		char name[FS_PATH_MAX_LENGTH + 1]; //!< Path buffer
 		unsigned char nameLength; //!< Length of the path buffer
 		struct FSSize size; //!< Size buffer
+		unsigned char offset[FS_OFFSET_SIZE]; //!< Seek offset buffer, little-endian
 		bool status; //!< Status buffer
 	} fs; //!< File System buffer
+	struct
+	{
+		unsigned char counter[PERF_COUNTER_SIZE * 2]; //!< Latched tick and instruction counters
+		unsigned char position; //!< Position of the next byte to read from the latched counters
+		unsigned char value; //!< Byte of the latched counters which is being read
+	} perf; //!< Performance counters buffer
+	struct
+	{
+		unsigned char string[LCD_STRING_MAX_LENGTH]; //!< Buffered chars of the string
+		unsigned char stringLength; //!< Length of the buffered string
+	} lcd; //!< LCD string buffer
 } static reg = {0};
 
 static unsigned char ioReadStatus(bool half);
-static unsigned char ioReadField(void);
+static unsigned char ioReadField(bool half);
 static unsigned char ioReadKeyboard(bool half);
 static unsigned char ioReadLCDCursorPosX(bool half);
 static unsigned char ioReadLCDCursorPosY(bool half);
@@ -155,6 +180,7 @@ static unsigned char ioReadRS232Rx(bool half);
 static unsigned char ioReadFSData(bool half);
 
 static void ioWriteCommand(bool half, unsigned char dataInRaw);
+static unsigned int ioGetMicroseconds(void);
 static void ioWriteStatusAddress(unsigned char dataInRaw);
 static void ioWriteFieldAddress(unsigned char dataInRaw);
 static void ioWriteField(bool half, unsigned char dataIn, unsigned char mask);
@@ -163,6 +189,8 @@ static void ioWriteLCDCursorPosX(bool half, unsigned char dataIn, unsigned char
 static void ioWriteLCDCursorPosY(bool half, unsigned char dataIn, unsigned char mask);
 static void ioWriteLCDChar(bool half, unsigned char dataIn, unsigned char mask);
 static void ioWriteCRS232Tx(bool half, unsigned char dataIn, unsigned char mask);
+static void ioWriteLCDString(bool half, unsigned char dataIn, unsigned char mask);
+static void ioFlushLCDString(void);
 static void ioWriteFSName(bool half, unsigned char dataIn, unsigned char mask);
 
 static void ioCreatePath(char *buffer, const char *dirName, const char *fileName);
@@ -299,9 +327,11 @@ unsigned char ioReadStatus(bool half)
 /**
  * Read a value of the selected field register
  *
+ * @param half Half of register selector
+ *
  * @return Read data
  */
-unsigned char ioReadField(void)
+unsigned char ioReadField(bool half)
 {
 	unsigned char data = 0;
 
@@ -315,6 +345,20 @@ unsigned char ioReadField(void)
 			data = reg.fs.size.high;
 			break;
 
+		case FS_DATA_SIZE_EXT :
+			data = reg.fs.size.ext;
+			break;
+
+		case PERF_COUNTER :
+			if(half == HALF_LOW)
+			{
+				reg.perf.value = reg.perf.counter[reg.perf.position];
+				reg.perf.position = ((reg.perf.position + 1) % (PERF_COUNTER_SIZE * 2));
+			}
+
+			data = reg.perf.value;
+			break;
+
 		case SPEAKER_BUFFER_FREE :
 			data = reg.speaker.bufferFree;
 			break;
@@ -467,7 +511,7 @@ void ioWriteCommand(bool half, unsigned char dataInRaw)
 		switch(dataInRaw)
 		{
 			case FS_OPEN_OS :
-				reg.fs.status = fsOpen("/os.bin", &(reg.fs.size));
+				reg.fs.status = fsOpen("/os.bin", &(reg.fs.size), FS_FILE_MAX_SIZE);
 				break;
 
 			case FS_RESET_NAME :
@@ -477,12 +521,25 @@ void ioWriteCommand(bool half, unsigned char dataInRaw)
 
 			case FS_OPEN_APP :
 				ioCreatePath(path, "/app", reg.fs.name);
-				reg.fs.status = fsOpen(path, &(reg.fs.size));
+				reg.fs.status = fsOpen(path, &(reg.fs.size), FS_FILE_MAX_SIZE);
 				break;
 
 			case FS_OPEN_FILE :
 				ioCreatePath(path, "/file", reg.fs.name);
-				reg.fs.status = fsOpen(path, &(reg.fs.size));
+				reg.fs.status = fsOpen(path, &(reg.fs.size), FS_FILE_MAX_SIZE);
+				break;
+
+			case FS_SEEK :
+				reg.fs.status = fsSeek(reg.fs.offset[0] | (reg.fs.offset[1] << 8) | (reg.fs.offset[2] << 16));
+				break;
+
+			case FS_OPEN_STREAM :
+				ioCreatePath(path, "/file", reg.fs.name);
+				reg.fs.status = fsOpen(path, &(reg.fs.size), FS_STREAM_MAX_SIZE);
+				break;
+
+			case FS_READ_BLOCK :
+				reg.fs.status = fsReadBlock();
 				break;
 
 			case FS_LIST_APP :
@@ -492,6 +549,22 @@ void ioWriteCommand(bool half, unsigned char dataInRaw)
 			case FS_LIST_FILE :
 				reg.fs.status = fsList("/file", &(reg.fs.size));
 				break;
+
+			case PERF_LATCH :
+			{
+				unsigned int ticks = ioGetMicroseconds();
+
+				for(int i = 0; i < PERF_COUNTER_SIZE; i++)
+				{
+					reg.perf.counter[i] = ((ticks >> (i * 8)) & 0xff);
+
+					// The IO board cannot see instructions executed by the CPU
+					reg.perf.counter[PERF_COUNTER_SIZE + i] = 0;
+				}
+
+				reg.perf.position = 0;
+				break;
+			}
 		}
 	}
 	else
@@ -625,6 +698,18 @@ void ioWriteField(bool half, unsigned char dataIn, unsigned char mask)
 				reg.rtc.second = data;
 				break;
 
+			case FS_OFFSET_LOW :
+				reg.fs.offset[0] = data;
+				break;
+
+			case FS_OFFSET_MIDDLE :
+				reg.fs.offset[1] = data;
+				break;
+
+			case FS_OFFSET_HIGH :
+				reg.fs.offset[2] = data;
+				break;
+
 			case SPEAKER_NOTE :
 				reg.speaker.note.note = data;
 				break;
@@ -765,6 +850,52 @@ void ioWriteFSName(bool half, unsigned char dataIn, unsigned char mask)
 	}
 }
 
+/**
+ * Add a char to the LCD string buffer. Zero prints the buffered string and refreshes the LCD once.
+ * A full buffer is printed without the refresh, so strings longer than the buffer are not cut.
+ *
+ * @param half Half of register selector
+ * @param dataIn Data to write
+ * @param mask Mask of input data
+ */
+void ioWriteLCDString(bool half, unsigned char dataIn, unsigned char mask)
+{
+	static unsigned char data = 0;
+
+	data = ((data & mask) | dataIn);
+
+	if(half == HALF_HIGH)
+	{
+		if(data == 0x00)
+		{
+			ioFlushLCDString();
+			
+			lcdRefresh();
+			lcdUpdate();
+		}
+		else
+		{
+			if(reg.lcd.stringLength >= LCD_STRING_MAX_LENGTH)
+			{
+				ioFlushLCDString();
+			}
+			
+			reg.lcd.string[reg.lcd.stringLength] = data;
+			reg.lcd.stringLength++;
+		}
+	}
+}
+
+//! Print chars from the LCD string buffer without the refresh
+static void ioFlushLCDString(void)
+{
+	if(reg.lcd.stringLength > 0)
+	{
+		lcdPrintString(reg.lcd.string, reg.lcd.stringLength);
+		reg.lcd.stringLength = 0;
+	}
+}
+
 /**
  * Create a path to file
  *
@@ -792,6 +923,36 @@ static void ioCreatePath(char *buffer, const char *dirName, const char *fileName
 	buffer[i] = 0x00;
 }
 
+/**
+ * Get the time since start of the board in microseconds. The CPU clock is 1 MHz so it is used as the tick counter.
+ *
+ * @return Time in microseconds
+ */
+unsigned int ioGetMicroseconds(void)
+{
+	unsigned int ms;
+	unsigned int value;
+	bool pending;
+
+	// Repeat if the SysTick handler has run during the read
+	do
+	{
+		ms = HAL_GetTick();
+		value = SysTick->VAL;
+		pending = ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0);
+	}
+	while(ms != HAL_GetTick());
+
+	// Inside an IRQ the SysTick handler cannot run, so a wrap only sets the pending bit. A reloaded counter means the millisecond is not counted yet.
+	if(pending && (value > (SysTick->LOAD / 2)))
+	{
+		ms++;
+	}
+
+	// The counter goes down from LOAD to 0
+	return((ms * 1000) + ((SysTick->LOAD - value) / (SystemCoreClock / 1000000)));
+}
+
 //! Process the IRQ event for the IO. It processes a new incoming request from the XiPU.
 void EXTI4_15_IRQHandler(void)
 {
@@ -802,6 +963,13 @@ void EXTI4_15_IRQHandler(void)
 		bool half = ((value & (1 << 4)) ? HALF_HIGH : HALF_LOW);
 		bool mode = ((value & (1 << 5)) ? MODE_DATA_TRANSFER : MODE_REG_SELECT);
 		bool rw = ((value & (1 << 6)) ? RW_WRITE : RW_READ);
+		bool prefetch = FALSE;
+
+		// Chars buffered by the LCD string register are printed before any other LCD operation, so the order of the output is kept
+		if((mode == MODE_DATA_TRANSFER) && (((regSelected >= REG_LCD_COLOR) && (regSelected <= REG_LCD_CHAR)) || ((regSelected == REG_COMMAND) && (rw == RW_WRITE) && (half == HALF_HIGH))))
+		{
+			ioFlushLCDString();
+		}
 
 		if(mode == MODE_REG_SELECT)
 		{
@@ -821,7 +989,7 @@ void EXTI4_15_IRQHandler(void)
 						break;
 
 					case REG_FIELD :
-						dataOut = ioReadField();
+						dataOut = ioReadField(half);
 						break;
 
 					case REG_KEYBOARD :
@@ -842,6 +1010,7 @@ void EXTI4_15_IRQHandler(void)
 
 					case REG_FS :
 						dataOut = ioReadFSData(half);
+						prefetch = (half == HALF_HIGH);
 						break;
 				}
 
@@ -906,6 +1075,10 @@ void EXTI4_15_IRQHandler(void)
 					case REG_FS :
 						ioWriteFSName(half, dataIn, mask);
 						break;
+
+					case REG_LCD_STRING :
+						ioWriteLCDString(half, dataIn, mask);
+						break;
 				}
 			}
 		}
@@ -914,5 +1087,11 @@ void EXTI4_15_IRQHandler(void)
 		
 		// Operation is completed
 		HAL_GPIO_TogglePin(GPIOB, GPIO_PIN_7);
+		
+		// In the streaming mode the register stays selected, so the next byte is fetched while the CPU stores the previous one
+		if(prefetch)
+		{
+			fsPrefetch();
+		}
 	}
 }
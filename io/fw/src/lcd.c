@@ -234,6 +234,48 @@ void lcdPrintChar(unsigned char c)
 	cursorPosX++;
 }
 
+/**
+ * Print a string at the cursor position. Chars are copied to the work buffer in runs which end at the end of a row.
+ *
+ * @param s String to print
+ * @param length Length of the string
+ */
+void lcdPrintString(const unsigned char *s, unsigned int length)
+{
+	unsigned int i = 0;
+	
+	while(i < length)
+	{
+		if(cursorPosX >= LCD_WIDTH)
+		{
+			cursorPosX = 0;
+			cursorPosY++;
+		}
+
+		if(cursorPosY >= LCD_HEIGHT)
+		{
+			lcdScrollDown();
+			cursorPosY = (LCD_HEIGHT - 1);
+		}
+		
+		unsigned int run = (LCD_WIDTH - cursorPosX);
+		
+		if(run > (length - i))
+		{
+			run = (length - i);
+		}
+		
+		for(unsigned int j = 0; j < run; j++)
+		{
+			charBuffer[LCD_BUFFER_WORK][cursorPosY][cursorPosX + j] = s[i + j];
+			colorBuffer[LCD_BUFFER_WORK][cursorPosY][cursorPosX + j] = cursorColor;
+		}
+		
+		cursorPosX += run;
+		i += run;
+	}
+}
+
 //! Set LCD update request flag to refresh the data on the screen
 void lcdUpdate(void)
 {
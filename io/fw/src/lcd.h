@@ -23,6 +23,8 @@
 #define LCD_MATRIX_WIDTH (LCD_CHAR_WIDTH * LCD_WIDTH) //!< Pixel matrix width
 #define LCD_MATRIX_HEIGHT (LCD_CHAR_HEIGHT * LCD_HEIGHT) //!< Pixel matrix height
 
+#define LCD_STRING_MAX_LENGTH LCD_WIDTH //!< Maximum length of a string buffered before it is printed
+
 void lcdInit(void);
 
 void lcdClear(void);
@@ -39,6 +41,7 @@ unsigned char lcdGetCursorPosX(void);
 unsigned char lcdGetCursorPosY(void);
 
 void lcdPrintChar(unsigned char c);
+void lcdPrintString(const unsigned char *s, unsigned int length);
 
 void lcdUpdate(void);
 
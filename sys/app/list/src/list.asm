@@ -106,9 +106,8 @@ var fileCount
 .main_errorOpen:
 	; Print open error
 	gp *fileListOpenError
-	call .xStringPrint
-	; Refresh the screen
-	call .xLcdRefresh
+	; Print and refresh the screen
+	call .xLcdPrintString
 	pop Y
 	pop X
 	pop B
@@ -119,9 +118,8 @@ var fileCount
 .main_warningEmpty:
 	; Print empty list message
 	gp *fileListIsEmpty
-	call .xStringPrint
-	; Refresh the screen
-	call .xLcdRefresh
+	; Print and refresh the screen
+	call .xLcdPrintString
 	pop Y
 	pop X
 	pop B
@@ -173,10 +173,8 @@ var toneDuration
 	call .xLcdNewLine
 	; Load address to bottom message
 	gp *keyHelpExit
-	; Print bottom message
-	call .xStringPrint
-	; Refresh the screen
-	call .xLcdRefresh
+	; Print bottom message and refresh the screen
+	call .xLcdPrintString
 	pop Y
 	pop X
 	pop B
@@ -204,10 +202,8 @@ var toneDuration
 	call .xStringPrintU8
 	; Load address to second part of tone duration string
 	gp *keyHelpMs
-	; Print second part of tone duration string
-	call .xStringPrint
-	; Refresh the screen
-	call .xLcdRefresh
+	; Print second part of tone duration string and refresh the screen
+	call .xLcdPrintString
 	pop Y
 	pop X
 	pop A
@@ -17,6 +17,8 @@ external .xStringPrint:
 	push X
 	push Y
 	push A
+	; Keep lcd char register selected
+	call .xLcdStreamBegin
 .xStringPrint_loop:
 	; Load char from RAM
 	ldp A
@@ -24,7 +26,7 @@ external .xStringPrint:
 	cmp 0, A
 	je .xStringPrint_end
 	; Print char
-	call .xLcdPrintChar
+	call .xIOStreamWrite
 	; Incrementing address
 	incp
 	jmp .xStringPrint_loop
@@ -248,11 +248,7 @@ const loadingErrorTooBigText "Error: The app file is too large"
 .terminalLoadApp_loadFileCopyDataLoopInit:
 	ldf 34, Y
 	clr X
-.terminalLoadApp_loadFileCopyDataLoop:
-	call .xFSGetNextDataByte
-	stp A
-	incp
-	loopz B, .terminalLoadApp_loadFileCopyDataLoop
+	call .xFsLoadBlock
 	stf Y, 34
 	ldf 33, Y
 	loopz Y, .terminalLoadApp_loadFileCopyBlockLoop
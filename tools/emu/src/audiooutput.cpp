@@ -0,0 +1,67 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "audiooutput.h"
+
+/**
+ * Constructor for the audio output class
+ *
+ * @param ring Ring with samples to play
+ * @param sampleRate Sample rate in Hz
+ * @param parent Parent object
+ */
+AudioOutput::AudioOutput(AudioRing *ring, int sampleRate, QObject *parent) : QObject(parent), stream(ring, this)
+{
+	this->audioFormat.setSampleRate(sampleRate);
+	this->audioFormat.setSampleSize(16);
+	this->audioFormat.setChannelCount(1);
+	this->audioFormat.setCodec("audio/pcm");
+	this->audioFormat.setByteOrder(static_cast<QAudioFormat::Endian>(QSysInfo::ByteOrder));
+	this->audioFormat.setSampleType(QAudioFormat::SignedInt);
+
+	this->volume = 1.0;
+}
+
+//! Destructor for the audio output class
+AudioOutput::~AudioOutput()
+{
+	if(!this->audioOutput.isNull())
+	{
+		this->audioOutput->stop();
+	}
+
+	this->stream.close();
+}
+
+//! Create the audio output on the current thread and start pulling samples
+void AudioOutput::startSlot()
+{
+	this->audioOutput.reset(new QAudioOutput(this->audioFormat));
+	this->audioOutput->setVolume(this->volume);
+
+	this->stream.open(QIODevice::ReadOnly);
+	this->audioOutput->start(&this->stream);
+}
+
+/**
+ * Set volume
+ *
+ * @param volume Volume level in range 0-1
+ */
+void AudioOutput::setVolumeSlot(qreal volume)
+{
+	this->volume = volume;
+
+	if(!this->audioOutput.isNull())
+	{
+		this->audioOutput->setVolume(volume);
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef AUDIOOUTPUT_H
+#define AUDIOOUTPUT_H
+
+#include <QObject>
+#include <QAudioFormat>
+#include <QAudioOutput>
+#include <QScopedPointer>
+#include <QSysInfo>
+
+#include "audioring.h"
+#include "audiostream.h"
+
+//! This class contains the audio output device working on the audio thread. It pulls samples from the audio ring.
+class AudioOutput : public QObject
+{
+	Q_OBJECT
+
+	public:
+		AudioOutput(AudioRing *ring, int sampleRate, QObject *parent = nullptr);
+		~AudioOutput() override;
+
+		AudioOutput(const AudioOutput &) = delete;
+		AudioOutput &operator=(const AudioOutput &) = delete;
+		AudioOutput(AudioOutput &&) = delete;
+		AudioOutput &operator=(AudioOutput &&) = delete;
+
+	private:
+		QAudioFormat audioFormat; //!< Audio stream parameter information
+		QScopedPointer<QAudioOutput> audioOutput; //!< Interface to an audio output device, created on the audio thread
+		AudioStream stream; //!< Device pulled by the audio output
+		qreal volume; //!< Volume level in range 0-1
+
+	public slots:
+		void startSlot();
+		void setVolumeSlot(qreal volume);
+};
+
+#endif
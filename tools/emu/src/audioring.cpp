@@ -0,0 +1,98 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include <algorithm>
+
+#include "audioring.h"
+
+//! Constructor for the audio ring class
+AudioRing::AudioRing() : writePos(0), readPos(0), flushPos(0)
+{
+}
+
+/**
+ * Write samples to the ring. It is called only by the producer thread.
+ *
+ * @param samples Samples to write
+ * @param count Quantity of samples
+ *
+ * @return Quantity of written samples, it is lower than count when the ring is full
+ */
+int AudioRing::write(const qint16 *samples, int count)
+{
+	const quint64 write = this->writePos.load(std::memory_order_relaxed);
+	const quint64 read = this->readPos.load(std::memory_order_acquire);
+
+	count = qMin(count, static_cast<int>(CAPACITY - (write - read)));
+
+	const int start = static_cast<int>(write & MASK);
+	const int first = qMin(count, (CAPACITY - start));
+
+	std::copy(samples, (samples + first), (this->data.data() + start));
+	std::copy((samples + first), (samples + count), this->data.data());
+
+	this->writePos.store((write + count), std::memory_order_release);
+
+	return(count);
+}
+
+/**
+ * Read samples from the ring. It is called only by the consumer thread.
+ *
+ * @param samples Buffer for the read samples
+ * @param count Quantity of samples to read
+ *
+ * @return Quantity of read samples, it is lower than count when the ring is empty
+ */
+int AudioRing::read(qint16 *samples, int count)
+{
+	// The flush position is loaded first. It never passes the write position, so a flush between the loads cannot move the read position past the write position.
+	const quint64 read = qMax(this->readPos.load(std::memory_order_relaxed), this->flushPos.load(std::memory_order_acquire));
+	const quint64 write = this->writePos.load(std::memory_order_acquire);
+
+	if(read >= write)
+	{
+		count = 0;
+	}
+	else
+	{
+		count = static_cast<int>(qMin(static_cast<quint64>(qMax(count, 0)), (write - read)));
+	}
+
+	const int start = static_cast<int>(read & MASK);
+	const int first = qMin(count, (CAPACITY - start));
+
+	std::copy((this->data.constData() + start), (this->data.constData() + start + first), samples);
+	std::copy(this->data.constData(), (this->data.constData() + (count - first)), (samples + first));
+
+	this->readPos.store((read + count), std::memory_order_release);
+
+	return(count);
+}
+
+//! Drop all written samples. It is called only by the producer thread, the consumer skips them on the next read. Their space is reused after that read, so the consumer never reads overwritten samples.
+void AudioRing::flush()
+{
+	this->flushPos.store(this->writePos.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+/**
+ * Get free space in the ring. It is called only by the producer thread.
+ *
+ * @return Quantity of samples that can be written
+ */
+int AudioRing::getFree() const
+{
+	const quint64 write = this->writePos.load(std::memory_order_relaxed);
+	const quint64 read = this->readPos.load(std::memory_order_acquire);
+
+	return(static_cast<int>(CAPACITY - (write - read)));
+}
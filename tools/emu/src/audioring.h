@@ -0,0 +1,43 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef AUDIORING_H
+#define AUDIORING_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include <atomic>
+
+//! This class contains a lock-free ring of audio samples for one producer thread and one consumer thread
+class AudioRing
+{
+	public:
+		static const int CAPACITY = (1 << 18); //!< Quantity of samples in the ring, it must be a power of two
+		static const int MASK = (CAPACITY - 1); //!< Mask of the position in the ring
+
+		AudioRing();
+
+		int write(const qint16 *samples, int count);
+		int read(qint16 *samples, int count);
+		void flush();
+
+		int getFree() const;
+
+	private:
+		QVector<qint16> data = QVector<qint16>(CAPACITY); //!< Samples
+
+		std::atomic<quint64> writePos; //!< Count of written samples, changed only by the producer
+		std::atomic<quint64> readPos; //!< Count of read samples, changed only by the consumer
+		std::atomic<quint64> flushPos; //!< Count of written samples at the last flush, the consumer skips everything before it
+};
+
+#endif
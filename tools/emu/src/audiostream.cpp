@@ -0,0 +1,75 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include <algorithm>
+
+#include "audiostream.h"
+
+/**
+ * Constructor for the audio stream class
+ *
+ * @param ring Ring with samples to play
+ * @param parent Parent object
+ */
+AudioStream::AudioStream(AudioRing *ring, QObject *parent) : QIODevice(parent)
+{
+	this->ring = ring;
+}
+
+/**
+ * Check if the device is sequential
+ *
+ * @return Always true
+ */
+bool AudioStream::isSequential() const
+{
+	return(true);
+}
+
+/**
+ * Get quantity of bytes available to read
+ *
+ * @return Quantity of bytes, samples are never missing because silence fills the gaps
+ */
+qint64 AudioStream::bytesAvailable() const
+{
+	return(AVAILABLE_BYTES + QIODevice::bytesAvailable());
+}
+
+/**
+ * Read samples for the audio output. The missing part is filled with silence.
+ *
+ * @param data Buffer for the samples
+ * @param maxSize Size of the buffer in bytes
+ *
+ * @return Quantity of read bytes
+ */
+qint64 AudioStream::readData(char *data, qint64 maxSize)
+{
+	const int count = static_cast<int>(maxSize / static_cast<qint64>(sizeof(qint16)));
+	qint16 *samples = reinterpret_cast<qint16 *>(data);
+
+	const int read = qBound(0, this->ring->read(samples, count), count);
+
+	std::fill((samples + read), (samples + count), static_cast<qint16>(0));
+
+	return(count * static_cast<qint64>(sizeof(qint16)));
+}
+
+/**
+ * Write data to the device. It is not supported.
+ *
+ * @return Always -1
+ */
+qint64 AudioStream::writeData(const char *, qint64)
+{
+	return(-1);
+}
@@ -0,0 +1,40 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef AUDIOSTREAM_H
+#define AUDIOSTREAM_H
+
+#include <QIODevice>
+
+#include "audioring.h"
+
+//! This class contains a sequential device pulled by the audio output. It reads samples from the audio ring and gives silence when the ring is empty.
+class AudioStream : public QIODevice
+{
+	Q_OBJECT
+
+	public:
+		static const qint64 AVAILABLE_BYTES = 4096; //!< Quantity of bytes always reported as available, so the audio output never stops pulling
+
+		AudioStream(AudioRing *ring, QObject *parent = nullptr);
+
+		bool isSequential() const override;
+		qint64 bytesAvailable() const override;
+
+	protected:
+		qint64 readData(char *data, qint64 maxSize) override;
+		qint64 writeData(const char *data, qint64 maxSize) override;
+
+	private:
+		AudioRing *ring; //!< Ring with samples to play
+};
+
+#endif
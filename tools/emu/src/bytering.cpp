@@ -0,0 +1,71 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include <algorithm>
+
+#include "bytering.h"
+
+//! Constructor for the byte ring class
+ByteRing::ByteRing() : writePos(0), readPos(0)
+{
+}
+
+/**
+ * Write bytes to the ring. It is called only by the producer thread.
+ *
+ * @param data Bytes to write
+ * @param count Quantity of bytes
+ *
+ * @return Quantity of written bytes, it is lower than count when the ring is full
+ */
+int ByteRing::write(const char *data, int count)
+{
+	const quint64 write = this->writePos.load(std::memory_order_relaxed);
+	const quint64 read = this->readPos.load(std::memory_order_acquire);
+
+	count = qMin(count, static_cast<int>(CAPACITY - (write - read)));
+
+	const int start = static_cast<int>(write & MASK);
+	const int first = qMin(count, (CAPACITY - start));
+
+	std::copy(data, (data + first), (this->data.data() + start));
+	std::copy((data + first), (data + count), this->data.data());
+
+	this->writePos.store((write + count), std::memory_order_release);
+
+	return(count);
+}
+
+/**
+ * Read bytes from the ring. It is called only by the consumer thread.
+ *
+ * @param data Buffer for the read bytes
+ * @param count Quantity of bytes to read
+ *
+ * @return Quantity of read bytes, it is lower than count when the ring is empty
+ */
+int ByteRing::read(char *data, int count)
+{
+	const quint64 write = this->writePos.load(std::memory_order_acquire);
+	const quint64 read = this->readPos.load(std::memory_order_relaxed);
+
+	count = qMin(count, static_cast<int>(write - read));
+
+	const int start = static_cast<int>(read & MASK);
+	const int first = qMin(count, (CAPACITY - start));
+
+	std::copy((this->data.constData() + start), (this->data.constData() + start + first), data);
+	std::copy(this->data.constData(), (this->data.constData() + (count - first)), (data + first));
+
+	this->readPos.store((read + count), std::memory_order_release);
+
+	return(count);
+}
@@ -0,0 +1,44 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef BYTERING_H
+#define BYTERING_H
+
+#include <QtGlobal>
+#include <QByteArray>
+
+#include <atomic>
+
+//! This class contains a lock-free ring of bytes for one producer thread and one consumer thread
+class ByteRing
+{
+	public:
+		static const int CAPACITY = (1 << 16); //!< Quantity of bytes in the ring, it must be a power of two
+		static const int MASK = (CAPACITY - 1); //!< Mask of the position in the ring
+
+		ByteRing();
+
+		ByteRing(const ByteRing &) = delete;
+		ByteRing &operator=(const ByteRing &) = delete;
+		ByteRing(ByteRing &&) = delete;
+		ByteRing &operator=(ByteRing &&) = delete;
+
+		int write(const char *data, int count);
+		int read(char *data, int count);
+
+	private:
+		QByteArray data = QByteArray(CAPACITY, 0); //!< Bytes
+
+		std::atomic<quint64> writePos; //!< Count of written bytes, changed only by the producer
+		std::atomic<quint64> readPos; //!< Count of read bytes, changed only by the consumer
+};
+
+#endif
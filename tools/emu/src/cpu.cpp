@@ -62,6 +62,7 @@ void CPU::setBios(const CPU::BIOS &bios)
 void CPU::run()
 {
 	this->stepMode = false;
+	this->breakpointSkip = true;
 
 	this->timer.setSingleShot(false);
 	this->timer.setInterval(INTERVAL);
@@ -72,6 +73,7 @@ void CPU::run()
 void CPU::step()
 {
 	this->stepMode = true;
+	this->breakpointSkip = true;
 
 	this->timer.setSingleShot(true);
 	this->timer.start(0);
@@ -91,6 +93,69 @@ void CPU::stop()
 	this->reset();
 }
 
+//! Execute a single instruction immediately. It is used by the debugger and does not emit the update signal.
+void CPU::stepInstruction()
+{
+	this->timer.stop();
+
+	this->executeInstruction();
+}
+
+/**
+ * Set or remove a breakpoint
+ *
+ * @param address Address of the instruction
+ * @param enable Status of the breakpoint
+ */
+void CPU::setBreakpoint(int address, bool enable)
+{
+	if((address < 0) || (address >= MEMORY_SIZE) || (this->breakpoints.testBit(address) == enable))
+	{
+		return;
+	}
+
+	this->breakpoints.setBit(address, enable);
+	this->breakpointCount += (enable ? 1 : -1);
+}
+
+//! Remove all breakpoints
+void CPU::clearBreakpoints()
+{
+	this->breakpoints.fill(false);
+	this->breakpointCount = 0;
+}
+
+/**
+ * Read a byte from the address space of the CPU. The BIOS is visible at its addresses like for the CPU.
+ *
+ * @param address Address to read
+ *
+ * @return Read value
+ */
+unsigned char CPU::readMemory(int address) const
+{
+	if(address < BIOS_SIZE)
+	{
+		return(this->bios.data[address]);
+	}
+
+	return(this->ram.data[address & (MEMORY_SIZE - 1)]);
+}
+
+/**
+ * Write a byte to the RAM. Writes to the BIOS addresses are ignored like for the CPU.
+ *
+ * @param address Address to write
+ * @param value Value to write
+ */
+void CPU::writeMemory(int address, unsigned char value)
+{
+	if(address >= BIOS_SIZE)
+	{
+		this->ram.data[address & (MEMORY_SIZE - 1)] = value;
+	}
+}
+
 /**
  * Get register buffer
  *
@@ -111,6 +176,147 @@ unsigned long long CPU::getTicks() const
 	return(this->ticks);
 }
 
+/**
+ * Get executed instructions counter value
+ *
+ * @return Executed instructions counter value
+ */
+unsigned long long CPU::getInstructions() const
+{
+	return(this->instructions);
+}
+
+/**
+ * Get the scheduler of events executed at the given tick of the CPU clock
+ *
+ * @return Scheduler
+ */
+Scheduler &CPU::getScheduler()
+{
+	return(this->scheduler);
+}
+
+/**
+ * Save registers, RAM and counters to the state stream. The uROM and the BIOS are a configuration, so they are not saved.
+ * The state can be saved only between the emulation steps when the scheduler has no pending events.
+ *
+ * @param stream State stream
+ */
+void CPU::saveState(QDataStream &stream) const
+{
+	stream << this->ticks << this->instructions;
+
+	stream << this->reg.a << this->reg.b << this->reg.x << this->reg.y << this->reg.d << this->reg.t;
+	stream << this->reg.c << this->reg.z << this->reg.i;
+	stream << this->reg.pch << this->reg.pcl << this->reg.sph << this->reg.spl << this->reg.maxSp;
+	stream << this->reg.bpl << this->reg.bph << this->reg.mah << this->reg.mal;
+	stream << this->reg.in << this->reg.out;
+
+	stream << this->ram.data;
+}
+
+/**
+ * Load registers, RAM and counters from the state stream
+ *
+ * @param stream State stream
+ *
+ * @return Status of loading the state
+ */
+bool CPU::loadState(QDataStream &stream)
+{
+	this->reset();
+
+	stream >> this->ticks >> this->instructions;
+
+	stream >> this->reg.a >> this->reg.b >> this->reg.x >> this->reg.y >> this->reg.d >> this->reg.t;
+	stream >> this->reg.c >> this->reg.z >> this->reg.i;
+	stream >> this->reg.pch >> this->reg.pcl >> this->reg.sph >> this->reg.spl >> this->reg.maxSp;
+	stream >> this->reg.bpl >> this->reg.bph >> this->reg.mah >> this->reg.mal;
+	stream >> this->reg.in >> this->reg.out;
+
+	stream >> this->ram.data;
+
+	if((stream.status() != QDataStream::Ok) || (this->ram.data.size() != MEMORY_SIZE) || (this->reg.c.size() != 2) || (this->reg.z.size() != 2))
+	{
+		this->ram.data.resize(MEMORY_SIZE);
+		this->reg.c.resize(2);
+		this->reg.z.resize(2);
+
+		this->reset();
+
+		return(false);
+	}
+
+	return(true);
+}
+
+/**
+ * Load an application to RAM and start it without rebooting the machine.
+ * The stack is rebuilt, so the application gets empty arguments and returns to the start of the OS.
+ * It can be called only between the emulation steps.
+ *
+ * @param app Application binary
+ *
+ * @return Status of starting the application
+ */
+bool CPU::startApp(const QByteArray &app)
+{
+	if(app.isEmpty() || (app.size() > MEMORY_APP_MAX_SIZE))
+	{
+		return(false);
+	}
+
+	// Complete pending events, so the IO board is ready for the new code
+	this->scheduler.process(Scheduler::NO_EVENT - 1);
+
+	std::copy(app.constBegin(), app.constEnd(), (this->ram.data.begin() + MEMORY_APP_ADDRESS));
+
+	// Empty arguments string at the bottom of the stack
+	this->ram.data[MEMORY_SP_ADDRESS] = 0x00;
+
+	this->reg.x = static_cast<unsigned char>(MEMORY_SP_ADDRESS & 0xff);
+	this->reg.y = static_cast<unsigned char>(MEMORY_SP_ADDRESS >> 8);
+
+	// Return address pushed like by the CALL instruction. The RET instruction increments it.
+	unsigned int returnAddress = static_cast<unsigned int>(MEMORY_OS_ADDRESS - 1);
+	unsigned int spAddress = static_cast<unsigned int>(MEMORY_SP_ADDRESS + 1);
+
+	this->ram.data[static_cast<int>(spAddress)] = static_cast<unsigned char>(returnAddress & 0xff);
+	this->ram.data[static_cast<int>(spAddress + 1)] = static_cast<unsigned char>(returnAddress >> 8);
+
+	spAddress += 2;
+
+	this->reg.sph = static_cast<unsigned char>(spAddress >> 8);
+	this->reg.spl = static_cast<unsigned char>(spAddress & 0xff);
+	this->reg.maxSp = spAddress;
+
+	this->reg.pch = static_cast<unsigned char>(MEMORY_APP_ADDRESS >> 8);
+	this->reg.pcl = static_cast<unsigned char>(MEMORY_APP_ADDRESS & 0xff);
+	this->reg.i = this->ram.data[MEMORY_APP_ADDRESS];
+
+	return(true);
+}
+
+/**
+ * Get first uROM buffer
+ *
+ * @return uROM buffer
+ */
+const CPU::UROM &CPU::getUrom0() const
+{
+	return(this->urom0);
+}
+
+/**
+ * Get second uROM buffer
+ *
+ * @return uROM buffer
+ */
+const CPU::UROM &CPU::getUrom1() const
+{
+	return(this->urom1);
+}
+
 /**
  * Get ROM buffer
  *
@@ -136,8 +342,10 @@ void CPU::reset()
 {
 	this->stepMode = false;
 	this->ticks = 0;
+	this->instructions = 0;
 
 	this->timer.stop();
+	this->scheduler.reset();
 
 	this->ram.data.fill(0);
 
@@ -288,11 +496,63 @@ void CPU::inSlot(unsigned char in)
 	}
 }
 
+/**
+ * Check if the emulation should stop on a breakpoint before executing the next instruction
+ *
+ * @return Status of hitting a breakpoint
+ */
+bool CPU::isBreakpoint()
+{
+	if(this->breakpointSkip)
+	{
+		this->breakpointSkip = false;
+
+		return(false);
+	}
+
+	if(this->breakpointCount == 0)
+	{
+		return(false);
+	}
+
+	return(this->breakpoints.testBit((static_cast<int>(this->reg.pch) << 8) + static_cast<int>(this->reg.pcl)));
+}
+
 //! Process one step of the emulation
 void CPU::emulation()
 {
 	unsigned long long tick = 0;
 
+	while(tick < TICKS_PER_INTERVAL)
+	{
+		if(this->isBreakpoint())
+		{
+			this->timer.stop();
+
+			emit breakpointSignal();
+			break;
+		}
+
+		tick += this->executeInstruction();
+
+		if(this->stepMode)
+		{
+			break;
+		}
+	}
+
+	emit updateSignal();
+}
+
+/**
+ * Execute a single instruction of the CPU
+ *
+ * @return Clock ticks used by the instruction
+ */
+unsigned int CPU::executeInstruction()
+{
+	unsigned int tick = 0;
+
 	unsigned char uromCycle = 0;
 	int uromAddress;
 	unsigned char urom0;
@@ -316,320 +576,320 @@ void CPU::emulation()
 	unsigned char valueAR = 0;
 	unsigned char valueB = 0;
 
-	while(tick < TICKS_PER_INTERVAL)
+	do
 	{
-		do
+		bool &regC = ((this->reg.i & INSTRUCTION_REG_CZ_SELECT_MASK) ? this->reg.c[1] : this->reg.c[0]);
+		bool &regZ = ((this->reg.i & INSTRUCTION_REG_CZ_SELECT_MASK) ? this->reg.z[1] : this->reg.z[0]);
+
+		uromAddress = (static_cast<int>(this->reg.i) << UROM_ADDRESS_INSTRUCTION_POSITION);
+		uromAddress += (static_cast<int>(uromCycle & UROM_ADDRESS_CYCLE_MASK) << UROM_ADDRESS_CYCLE_POSITION);
+		uromAddress += (static_cast<int>(regC ? 1 : 0) << UROM_ADDRESS_FLAG_C_POSITION);
+		uromAddress += (static_cast<int>(regZ ? 1 : 0) << UROM_ADDRESS_FLAG_Z_POSITION);
+
+		urom0 = this->urom0.data[uromAddress];
+		urom1 = this->urom1.data[uromAddress];
+
+		uromCycle++;
+
+		busAR = static_cast<BusAR>((urom0 & UROM_0_BUS_AR_MASK) >> UROM_0_BUS_AR_POSITION);
+		busAW = static_cast<BusAW>((urom0 & UROM_0_BUS_AW_MASK) >> UROM_0_BUS_AW_POSITION);
+		busB = static_cast<BusB>((urom0 & UROM_0_BUS_B_MASK) >> UROM_0_BUS_B_POSITION);
+		busC = static_cast<BusC>((urom1 & UROM_1_BUS_C_MASK) >> UROM_1_BUS_C_POSITION);
+
+		aluS = ((urom1 & UROM_1_ALU_S_MASK) >> UROM_1_ALU_S_POSITION);
+		aluM = ((urom1 & UROM_1_ALU_M_MASK) != 0);
+		aluC = ((urom1 & UROM_1_ALU_C_MASK) != 0);
+
+		if((busAR == BusAR::ABXY) && (busAW == BusAW::ABXY))
+		{
+			busARregABXY = ((this->reg.i & INSTRUCTION_REG_ABXY_SECOND_MASK) >> INSTRUCTION_REG_ABXY_SECOND_OFFSET);
+		}
+		else
+		{
+			busARregABXY = ((this->reg.i & INSTRUCTION_REG_ABXY_FIRST_MASK) >> INSTRUCTION_REG_ABXY_FIRST_OFFSET);
+		}
+
+		busAWregABXY = (this->reg.i & INSTRUCTION_REG_ABXY_FIRST_MASK);
+		busBregAB = ((this->reg.i & INSTRUCTION_REG_AB_MASK) >> INSTRUCTION_REG_AB_OFFSET);
+
+		switch(busC)
 		{
-			bool &regC = ((this->reg.i & INSTRUCTION_REG_CZ_SELECT_MASK) ? this->reg.c[1] : this->reg.c[0]);
-			bool &regZ = ((this->reg.i & INSTRUCTION_REG_CZ_SELECT_MASK) ? this->reg.z[1] : this->reg.z[0]);
-
-			uromAddress = (static_cast<int>(this->reg.i) << UROM_ADDRESS_INSTRUCTION_POSITION);
-			uromAddress += (static_cast<int>(uromCycle & UROM_ADDRESS_CYCLE_MASK) << UROM_ADDRESS_CYCLE_POSITION);
-			uromAddress += (static_cast<int>(regC ? 1 : 0) << UROM_ADDRESS_FLAG_C_POSITION);
-			uromAddress += (static_cast<int>(regZ ? 1 : 0) << UROM_ADDRESS_FLAG_Z_POSITION);
-
-			urom0 = this->urom0.data[uromAddress];
-			urom1 = this->urom1.data[uromAddress];
-
-			uromCycle++;
-
-			busAR = static_cast<BusAR>((urom0 & UROM_0_BUS_AR_MASK) >> UROM_0_BUS_AR_POSITION);
-			busAW = static_cast<BusAW>((urom0 & UROM_0_BUS_AW_MASK) >> UROM_0_BUS_AW_POSITION);
-			busB = static_cast<BusB>((urom0 & UROM_0_BUS_B_MASK) >> UROM_0_BUS_B_POSITION);
-			busC = static_cast<BusC>((urom1 & UROM_1_BUS_C_MASK) >> UROM_1_BUS_C_POSITION);
-
-			aluS = ((urom1 & UROM_1_ALU_S_MASK) >> UROM_1_ALU_S_POSITION);
-			aluM = ((urom1 & UROM_1_ALU_M_MASK) != 0);
-			aluC = ((urom1 & UROM_1_ALU_C_MASK) != 0);
-
-			if((busAR == BusAR::ABXY) && (busAW == BusAW::ABXY))
-			{
-				busARregABXY = ((this->reg.i & INSTRUCTION_REG_ABXY_SECOND_MASK) >> INSTRUCTION_REG_ABXY_SECOND_OFFSET);
-			}
-			else
-			{
-				busARregABXY = ((this->reg.i & INSTRUCTION_REG_ABXY_FIRST_MASK) >> INSTRUCTION_REG_ABXY_FIRST_OFFSET);
-			}
-
-			busAWregABXY = (this->reg.i & INSTRUCTION_REG_ABXY_FIRST_MASK);
-			busBregAB = ((this->reg.i & INSTRUCTION_REG_AB_MASK) >> INSTRUCTION_REG_AB_OFFSET);
-
-			switch(busC)
-			{
-				case BusC::PC :
-					address = ((static_cast<int>(this->reg.pch) << 8) + static_cast<int>(this->reg.pcl));
-					break;
-
-				case BusC::MA :
-					address = ((static_cast<int>(this->reg.mah) << 8) + static_cast<int>(this->reg.mal));
-					break;
-
-				case BusC::SP :
-					address = ((static_cast<int>(this->reg.sph) << 8) + static_cast<int>(this->reg.spl));
-					break;
-
-				case BusC::XY :
-					address = ((static_cast<int>(this->reg.y) << 8) + static_cast<int>(this->reg.x));
-					break;
-			}
-
-			switch(busAR)
-			{
-				case BusAR::ABXY :
-					switch(busARregABXY)
-					{
-						case 0 :
-							valueAR = this->reg.a;
-							break;
-
-						case 1 :
-							valueAR = this->reg.b;
-							break;
-
-						case 2 :
-							valueAR = this->reg.x;
-							break;
-
-						case 3 :
-							valueAR = this->reg.y;
-							break;
-					}
-					break;
-
-				case BusAR::D :
-					valueAR = this->reg.d;
-					break;
-
-				case BusAR::IN :
-					valueAR = this->reg.in;
-					break;
-
-				case BusAR::T :
-					valueAR = this->reg.t;
-					break;
-
-				case BusAR::RAM :
-					if(address < BIOS_SIZE)
-					{
-						valueAR = this->bios.data[address];
-					}
-					else
-					{
-						valueAR = this->ram.data[address];
-					}
-					break;
-
-				case BusAR::PC :
-					if(busB == BusB::Low)
-					{
-						valueAR = this->reg.pcl;
-					}
-					else
-					{
-						valueAR = this->reg.pch;
-					}
-					break;
-
-				case BusAR::SP :
-					if(busB == BusB::Low)
-					{
-						valueAR = this->reg.spl;
-					}
-					else
-					{
-						valueAR = this->reg.sph;
-					}
-					break;
-
-				case BusAR::BP :
-					if(busB == BusB::Low)
-					{
-						valueAR = this->reg.bpl;
-					}
-					else
-					{
-						valueAR = this->reg.bph;
-					}
-					break;
-			}
-
-			switch(busB)
-			{
-				case BusB::AB :
-					switch(busBregAB)
-					{
-						case 0 :
-							valueB = this->reg.a;
-							break;
-
-						case 1 :
-							valueB = this->reg.b;
-							break;
-					}
-					break;
-
-				case BusB::D :
-					valueB = this->reg.d;
-					break;
-			}
-
-			switch(busAW)
-			{
-				case BusAW::None :
-					break;
-
-				case BusAW::ABXY :
-					switch(busAWregABXY)
-					{
-						case 0 :
-							this->reg.a = valueAR;
-							break;
-
-						case 1 :
-							this->reg.b = valueAR;
-							break;
-
-						case 2 :
-							this->reg.x = valueAR;
-							break;
-
-						case 3 :
-							this->reg.y = valueAR;
-							break;
-					}
-					break;
-
-				case BusAW::D :
-					this->reg.d = valueAR;
-					break;
-
-				case BusAW::OUT :
-					{
-						this->reg.out = valueAR;
-
-						emit outSignal(this->reg.out);
-					}
-					break;
-
-				case BusAW::ALU_T :
-					{
-						QVector<bool> z(2);
-						bool c = aluC;
-						unsigned char value = 0;
-
-						value = this->alu((valueAR & ALU_4BIT_MASK), (valueB & ALU_4BIT_MASK), aluS, aluM, c, z[0]);
-						value += (this->alu((valueAR >> ALU_4BIT_OFFSET), (valueB >> ALU_4BIT_OFFSET), aluS, aluM, c, z[1]) << ALU_4BIT_OFFSET);
-
-						this->reg.t = value;
-						regC = c;
-						regZ = (z[0] & z[1]);
-					}
-					break;
-
-				case BusAW::RPC :
+			case BusC::PC :
+				address = ((static_cast<int>(this->reg.pch) << 8) + static_cast<int>(this->reg.pcl));
+				break;
+
+			case BusC::MA :
+				address = ((static_cast<int>(this->reg.mah) << 8) + static_cast<int>(this->reg.mal));
+				break;
+
+			case BusC::SP :
+				address = ((static_cast<int>(this->reg.sph) << 8) + static_cast<int>(this->reg.spl));
+				break;
+
+			case BusC::XY :
+				address = ((static_cast<int>(this->reg.y) << 8) + static_cast<int>(this->reg.x));
+				break;
+		}
+
+		switch(busAR)
+		{
+			case BusAR::ABXY :
+				switch(busARregABXY)
+				{
+					case 0 :
+						valueAR = this->reg.a;
+						break;
+
+					case 1 :
+						valueAR = this->reg.b;
+						break;
+
+					case 2 :
+						valueAR = this->reg.x;
+						break;
+
+					case 3 :
+						valueAR = this->reg.y;
+						break;
+				}
+				break;
+
+			case BusAR::D :
+				valueAR = this->reg.d;
+				break;
+
+			case BusAR::IN :
+				valueAR = this->reg.in;
+				break;
+
+			case BusAR::T :
+				valueAR = this->reg.t;
+				break;
+
+			case BusAR::RAM :
+				if(address < BIOS_SIZE)
+				{
+					valueAR = this->bios.data[address];
+				}
+				else
+				{
+					valueAR = this->ram.data[address];
+				}
+				break;
+
+			case BusAR::PC :
+				if(busB == BusB::Low)
+				{
+					valueAR = this->reg.pcl;
+				}
+				else
+				{
+					valueAR = this->reg.pch;
+				}
+				break;
+
+			case BusAR::SP :
+				if(busB == BusB::Low)
+				{
+					valueAR = this->reg.spl;
+				}
+				else
+				{
+					valueAR = this->reg.sph;
+				}
+				break;
+
+			case BusAR::BP :
+				if(busB == BusB::Low)
+				{
+					valueAR = this->reg.bpl;
+				}
+				else
+				{
+					valueAR = this->reg.bph;
+				}
+				break;
+		}
+
+		switch(busB)
+		{
+			case BusB::AB :
+				switch(busBregAB)
+				{
+					case 0 :
+						valueB = this->reg.a;
+						break;
+
+					case 1 :
+						valueB = this->reg.b;
+						break;
+				}
+				break;
+
+			case BusB::D :
+				valueB = this->reg.d;
+				break;
+		}
+
+		switch(busAW)
+		{
+			case BusAW::None :
+				break;
+
+			case BusAW::ABXY :
+				switch(busAWregABXY)
+				{
+					case 0 :
+						this->reg.a = valueAR;
+						break;
+
+					case 1 :
+						this->reg.b = valueAR;
+						break;
+
+					case 2 :
+						this->reg.x = valueAR;
+						break;
+
+					case 3 :
+						this->reg.y = valueAR;
+						break;
+				}
+				break;
+
+			case BusAW::D :
+				this->reg.d = valueAR;
+				break;
+
+			case BusAW::OUT :
+				{
+					this->reg.out = valueAR;
+
+					emit counterSignal(this->ticks, this->instructions);
+					emit outSignal(this->reg.out);
+				}
+				break;
+
+			case BusAW::ALU_T :
+				{
+					QVector<bool> z(2);
+					bool c = aluC;
+					unsigned char value = 0;
+
+					value = this->alu((valueAR & ALU_4BIT_MASK), (valueB & ALU_4BIT_MASK), aluS, aluM, c, z[0]);
+					value += (this->alu((valueAR >> ALU_4BIT_OFFSET), (valueB >> ALU_4BIT_OFFSET), aluS, aluM, c, z[1]) << ALU_4BIT_OFFSET);
+
+					this->reg.t = value;
+					regC = c;
+					regZ = (z[0] & z[1]);
+				}
+				break;
+
+			case BusAW::RPC :
+				uromCycle = 0;
+				break;
+
+			case BusAW::I :
+				this->reg.i = valueAR;
+				break;
+
+			case BusAW::RAM :
+				if(address >= BIOS_SIZE)
+				{
+					this->ram.data[address] = valueAR;
+				}
+				break;
+
+			case BusAW::PC :
+				if(busB == BusB::Low)
+				{
+					this->reg.pcl = valueAR;
+				}
+				else
+				{
+					this->reg.pch = valueAR;
+				}
+				break;
+
+			case BusAW::SP :
+				if(busB == BusB::Low)
+				{
+					this->reg.spl = valueAR;
+				}
+				else
+				{
+					this->reg.sph = (static_cast<unsigned char>(MEMORY_SP_ADDRESS >> 8) | valueAR);
+				}
+				break;
+
+			case BusAW::BP :
+				if(busB == BusB::Low)
+				{
+					this->reg.bpl = valueAR;
+				}
+				else
+				{
+					this->reg.bph = valueAR;
+				}
+				break;
+
+			case BusAW::MA :
+				if(busB == BusB::Low)
+				{
+					this->reg.mal = valueAR;
+				}
+				else
+				{
+					this->reg.mah = valueAR;
+				}
+				break;
+
+			case BusAW::PC_PLUS :
+				{
+					unsigned int pcAddress = ((static_cast<unsigned int>(this->reg.pch) << 8) + static_cast<unsigned int>(this->reg.pcl) + 1);
+
+					this->reg.pch = static_cast<unsigned char>(pcAddress >> 8);
+					this->reg.pcl = static_cast<unsigned char>(pcAddress & 0xff);
+				}
+				break;
+
+			case BusAW::SP_PLUS :
+				this->reg.spl++;
+				this->reg.maxSp = qMax(this->reg.maxSp, ((static_cast<unsigned int>(this->reg.sph) << 8) + static_cast<unsigned int>(this->reg.spl)));
+				break;
+
+			case BusAW::SP_MINUS :
+				this->reg.spl--;
+				break;
+
+			case BusAW::RPC_PLUS :
+				{
+					unsigned int pcAddress = ((static_cast<unsigned int>(this->reg.pch) << 8) + static_cast<unsigned int>(this->reg.pcl) + 1);
+
+					this->reg.pch = static_cast<unsigned char>(pcAddress >> 8);
+					this->reg.pcl = static_cast<unsigned char>(pcAddress & 0xff);
+
 					uromCycle = 0;
-					break;
-
-				case BusAW::I :
-					this->reg.i = valueAR;
-					break;
-
-				case BusAW::RAM :
-					if(address >= BIOS_SIZE)
-					{
-						this->ram.data[address] = valueAR;
-					}
-					break;
-
-				case BusAW::PC :
-					if(busB == BusB::Low)
-					{
-						this->reg.pcl = valueAR;
-					}
-					else
-					{
-						this->reg.pch = valueAR;
-					}
-					break;
-
-				case BusAW::SP :
-					if(busB == BusB::Low)
-					{
-						this->reg.spl = valueAR;
-					}
-					else
-					{
-						this->reg.sph = (static_cast<unsigned char>(MEMORY_SP_ADDRESS >> 8) | valueAR);
-					}
-					break;
-
-				case BusAW::BP :
-					if(busB == BusB::Low)
-					{
-						this->reg.bpl = valueAR;
-					}
-					else
-					{
-						this->reg.bph = valueAR;
-					}
-					break;
-
-				case BusAW::MA :
-					if(busB == BusB::Low)
-					{
-						this->reg.mal = valueAR;
-					}
-					else
-					{
-						this->reg.mah = valueAR;
-					}
-					break;
-
-				case BusAW::PC_PLUS :
-					{
-						unsigned int pcAddress = ((static_cast<unsigned int>(this->reg.pch) << 8) + static_cast<unsigned int>(this->reg.pcl) + 1);
-
-						this->reg.pch = static_cast<unsigned char>(pcAddress >> 8);
-						this->reg.pcl = static_cast<unsigned char>(pcAddress & 0xff);
-					}
-					break;
-
-				case BusAW::SP_PLUS :
-					this->reg.spl++;
-					this->reg.maxSp = qMax(this->reg.maxSp, ((static_cast<unsigned int>(this->reg.sph) << 8) + static_cast<unsigned int>(this->reg.spl)));
-					break;
-
-				case BusAW::SP_MINUS :
-					this->reg.spl--;
-					break;
-
-				case BusAW::RPC_PLUS :
-					{
-						unsigned int pcAddress = ((static_cast<unsigned int>(this->reg.pch) << 8) + static_cast<unsigned int>(this->reg.pcl) + 1);
-
-						this->reg.pch = static_cast<unsigned char>(pcAddress >> 8);
-						this->reg.pcl = static_cast<unsigned char>(pcAddress & 0xff);
-
-						uromCycle = 0;
-					}
-					break;
-			}
-
-			tick++;
-			this->ticks++;
-
-			if((this->ticks % CLOCK_TICKS_PER_INTERVAL) == 0)
-			{
-				this->reg.in ^= IO::IN_CLOCK_BIT;
-			}
+				}
+				break;
 		}
-		while(uromCycle > 0);
 
-		if(this->stepMode)
+		tick++;
+		this->ticks++;
+
+		if((this->ticks % CLOCK_TICKS_PER_INTERVAL) == 0)
 		{
-			break;
+			this->reg.in ^= IO::IN_CLOCK_BIT;
+		}
+
+		if(this->ticks >= this->scheduler.getNextTick())
+		{
+			this->scheduler.process(this->ticks);
 		}
 	}
+	while(uromCycle > 0);
 
-	emit updateSignal();
+	this->instructions++;
+
+	return(tick);
 }
@@ -15,8 +15,14 @@
 #include <QObject>
 #include <QVector>
 #include <QTimer>
+#include <QDataStream>
+#include <QByteArray>
+#include <QBitArray>
+
+#include <algorithm>
 
 #include "io.h"
+#include "scheduler.h"
 
 //! This class contains CPU contex and functions
 class CPU : public QObject
@@ -44,6 +50,7 @@ class CPU : public QObject
 		static const int MEMORY_OS_ADDRESS = 0x0800; //!< Start of OS address space
 		static const int MEMORY_APP_ADDRESS = 0x2000; //!< Start of Application address space
 		static const int MEMORY_SP_ADDRESS = 0xf000; //!< Start of Stack Pointer address space
+		static const int MEMORY_APP_MAX_SIZE = (MEMORY_SP_ADDRESS - MEMORY_APP_ADDRESS); //!< Maximum size of an application
 
 		static const unsigned char UROM_ADDRESS_CYCLE_MASK = 0x0f; //!< Micro-step mask of the CPU step for uROM
 
@@ -134,9 +141,27 @@ class CPU : public QObject
 		void pause();
 		void stop();
 
+		void stepInstruction();
+
+		void setBreakpoint(int address, bool enable);
+		void clearBreakpoints();
+
+		unsigned char readMemory(int address) const;
+		void writeMemory(int address, unsigned char value);
+
 		const CPU::Reg &getReg() const;
 		unsigned long long getTicks() const;
+		unsigned long long getInstructions() const;
+
+		Scheduler &getScheduler();
 
+		void saveState(QDataStream &stream) const;
+		bool loadState(QDataStream &stream);
+
+		bool startApp(const QByteArray &app);
+
+		const CPU::UROM &getUrom0() const;
+		const CPU::UROM &getUrom1() const;
 		const CPU::BIOS &getBios() const;
 		const CPU::RAM &getRam() const;
 
@@ -195,11 +220,20 @@ class CPU : public QObject
 
 		void reset();
 
+		bool isBreakpoint();
+		unsigned int executeInstruction();
+
 		unsigned char alu(unsigned char a, unsigned char b, unsigned char s, bool m, bool &c, bool &z);
 
 		bool stepMode; //!< Step mode enabler for emulation
 		unsigned long long ticks; //!< Counter of clock ticks of CPU
+		unsigned long long instructions; //!< Counter of executed instructions
 		QTimer timer; //!< Timer for executing emulation steps
+		Scheduler scheduler; //!< Queue of events executed at the given tick of the CPU clock
+
+		QBitArray breakpoints = QBitArray(MEMORY_SIZE); //!< Bitmap of addresses where the emulation stops before executing an instruction
+		int breakpointCount = 0; //!< Quantity of set breakpoints
+		bool breakpointSkip = false; //!< Do not stop on the breakpoint at the first instruction after resuming
 
 		UROM urom0; //!< First uROM memory buffer
 		UROM urom1; //!< Second uROM memory buffer
@@ -209,6 +243,8 @@ class CPU : public QObject
 		Reg reg; //!< Register buffer
 
 	signals:
+		void breakpointSignal();
+		void counterSignal(unsigned long long ticks, unsigned long long instructions);
 		void outSignal(unsigned char out);
 		void updateSignal();
 
@@ -17,14 +17,27 @@
  *
  * @param parent Parent object
  */
-Emu::Emu(QWidget *parent) : QMainWindow(parent), ui(new Ui::Emu)
+Emu::Emu(QWidget *parent) : QMainWindow(parent), ui(new Ui::Emu), ramModel(&this->cpu)
 {
 	ui->setupUi(this);
 
+	this->ui->ramView->setModel(&this->ramModel);
+
+	QObject::connect(this->ui->ramView->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(ramScrolledSlot()));
+
 	this->loaded = false;
 	this->started = false;
 	this->running = false;
 
+	this->snapshotEnabled = true;
+	this->snapshotPending = false;
+	this->idleOperations = 0;
+
+	this->headless = false;
+	this->exitTicks = 0;
+
+	this->inputScriptPending = false;
+
 	this->ui->fileUrom0PathLabel->setText("");
 	this->ui->fileUrom1PathLabel->setText("");
 	this->ui->fileBiosPathLabel->setText("");
@@ -36,35 +49,574 @@ Emu::Emu(QWidget *parent) : QMainWindow(parent), ui(new Ui::Emu)
 	this->ui->speakerVolumeSlider->setValue(50);
 	this->ui->speakerVolumeValueLabel->setText("50%");
 
+	this->ui->lcdFramesValueLabel->setText("0 / 0");
+
 	this->setFocus();
 
-	QObject::connect(&this->cpu, SIGNAL(updateSignal()), this, SLOT(updateSlot()));
+	this->io.setScheduler(&this->cpu.getScheduler());
+
+	this->appReloadTimer.setSingleShot(true);
+	this->appReloadTimer.setInterval(APP_RELOAD_DELAY);
+
+	QObject::connect(&this->appWatcher, SIGNAL(fileChanged(QString)), this, SLOT(appChangedSlot()));
+	QObject::connect(&this->appReloadTimer, SIGNAL(timeout()), this, SLOT(appReloadSlot()));
+
+	this->ui->rs232TxText->setMaximumBlockCount(RS232_VIEW_LINES);
+	this->ui->rs232RxText->setMaximumBlockCount(RS232_VIEW_LINES);
+
+	this->rs232ViewTimer.setSingleShot(true);
+	this->rs232ViewTimer.setInterval(RS232_VIEW_INTERVAL);
 
-	QObject::connect(&this->io, SIGNAL(updateLCDBufferSignal(LCD::Buffer)), ui->lcdBufferView, SLOT(drawSlot(LCD::Buffer)));
+	QObject::connect(&this->rs232ViewTimer, SIGNAL(timeout()), this, SLOT(rs232ViewSlot()));
+
+	this->viewTimer.setInterval(VIEW_INTERVAL);
+	this->viewValid = false;
+	this->viewMs = 0;
+	this->viewRTC = 0;
+
+	QObject::connect(&this->viewTimer, SIGNAL(timeout()), this, SLOT(updateSlot()));
+
+	QObject::connect(&this->cpu, SIGNAL(updateSignal()), this, SLOT(stepSlot()));
+
+	QObject::connect(&this->io, SIGNAL(updateLCDCellsSignal(LCD::Cells)), ui->lcdBufferView, SLOT(drawSlot(LCD::Cells)));
+	QObject::connect(&this->io, SIGNAL(updateLCDFramesSignal(unsigned long long, unsigned long long)), this, SLOT(updateLCDFramesSlot(unsigned long long, unsigned long long)));
 
 	QObject::connect(&this->io, SIGNAL(updateLEDRunSignal(bool)), this, SLOT(updateLEDRunSlot(bool)));
 	QObject::connect(&this->io, SIGNAL(updateLEDErrorSignal(bool)), this, SLOT(updateLEDErrorSlot(bool)));
 
-	QObject::connect(&this->io, SIGNAL(updateRS232TxSignal(unsigned char)), this, SLOT(updateRS232TxSlot(unsigned char)));
-	QObject::connect(&this->io, SIGNAL(updateRS232RxSignal(unsigned char)), this, SLOT(updateRS232RxSlot(unsigned char)));
+	QObject::connect(&this->io, SIGNAL(updateRS232TxSignal(QByteArray)), this, SLOT(updateRS232TxSlot(QByteArray)));
+	QObject::connect(&this->io, SIGNAL(updateRS232RxSignal(QByteArray)), this, SLOT(updateRS232RxSlot(QByteArray)));
+
+	QObject::connect(&this->io, SIGNAL(updateRTCDateTimeSignal(QDateTime)), this, SLOT(updateRTCDateTimeSlot(QDateTime)));
+
+	QObject::connect(&this->io, SIGNAL(updateSpeakerStatusSignal(int)), this, SLOT(updateSpeakerStatusSlot(int)));
+
+	QObject::connect(&this->cpu, SIGNAL(counterSignal(unsigned long long, unsigned long long)), &this->io, SLOT(counterSlot(unsigned long long, unsigned long long)));
+	QObject::connect(&this->cpu, SIGNAL(outSignal(unsigned char)), &this->io, SLOT(outSlot(unsigned char)));
+	QObject::connect(&this->io, SIGNAL(inSignal(unsigned char)), &this->cpu, SLOT(inSlot(unsigned char)));
+}
+
+//! Destructor for the emulator class
+Emu::~Emu()
+{
+	this->gdbServer.reset();
+	this->inputScript.reset();
+	this->network.reset();
+	this->rs232Bridge.reset();
+	this->lcdCapture.reset();
+
+	QObject::disconnect(&this->io);
+	QObject::disconnect(&this->cpu);
+
+	QObject::disconnect(this);
+
+	delete ui;
+}
+
+/**
+ * Set emulation of the IO board processing time. When it is disabled every IO operation is completed instantly.
+ *
+ * @param enable Enable status
+ */
+void Emu::setIOLatency(bool enable)
+{
+	this->io.setLatency(enable ? IO::boardLatency() : IO::Latency());
+}
+
+/**
+ * Emulate the IO board processing time with the model of the real board changed by the table from the file
+ *
+ * @param path Path to the table file
+ *
+ * @return Status of loading the table
+ */
+bool Emu::setIOLatencyTable(const QString &path)
+{
+	IO::Latency latency = IO::boardLatency();
+	QString error;
+
+	if(!IO::loadLatency(path, latency, error))
+	{
+		this->showError(error);
+		return(false);
+	}
+
+	this->io.setLatency(latency);
+
+	return(true);
+}
+
+/**
+ * Set using of the cache of the machine states taken when the OS reaches its idle prompt
+ *
+ * @param enable Enable status
+ */
+void Emu::setSnapshotEnabled(bool enable)
+{
+	this->snapshotEnabled = enable;
+}
+
+/**
+ * Set the maximum quantity of presented LCD frames per second. Refreshes requested by the guest faster are merged.
+ *
+ * @param fps Frames per second, 0 presents every refresh immediately
+ */
+void Emu::setLCDFPS(int fps)
+{
+	this->io.lcdSetFPS(fps);
+}
+
+/**
+ * Set smoothing of the square wave edges of the speaker to limit aliasing of high notes
+ *
+ * @param enable Enable status
+ */
+void Emu::setSpeakerBandLimited(bool enable)
+{
+	this->io.speakerSetBandLimited(enable);
+}
+
+/**
+ * Set playing sound on the audio device. When it is disabled, notes only advance in the emulated time.
+ *
+ * @param enable Enable status
+ */
+void Emu::setAudioDeviceEnabled(bool enable)
+{
+	this->io.speakerSetDeviceEnabled(enable);
+}
+
+/**
+ * Set the WAV file for the sound played by the speaker
+ *
+ * @param path Path to the WAV file
+ *
+ * @return Status of creating the file
+ */
+bool Emu::setAudioWavPath(const QString &path)
+{
+	if(!this->io.speakerSetWavPath(path))
+	{
+		this->showError("Unable to create the WAV file");
+		return(false);
+	}
+
+	return(true);
+}
+
+/**
+ * Set the source of the RTC time
+ *
+ * @param wall Follow the host wall time instead of the emulated time
+ * @param epoch Date and time of the emulated clock after a reset in the ISO 8601 format, empty value keeps the default
+ *
+ * @return Status of parsing the epoch
+ */
+bool Emu::setRTC(bool wall, const QString &epoch)
+{
+	QDateTime epochDateTime(QDate(2000, 1, 1), QTime(0, 0, 0));
+
+	if(!epoch.isEmpty())
+	{
+		epochDateTime = QDateTime::fromString(epoch, Qt::ISODate);
+
+		if(!epochDateTime.isValid() || (epochDateTime.date().year() < 2000) || (epochDateTime.date().year() > 2099))
+		{
+			this->showError("Bad RTC epoch, use yyyy-MM-ddThh:mm:ss from the years 2000-2099");
+			return(false);
+		}
+	}
+
+	this->io.rtcSetMode((wall ? RTC::Mode::Wall : RTC::Mode::Emulated), epochDateTime);
+
+	this->ui->rtcValueLabel->setText(this->io.rtcGetDateTime().toString("yyyy.MM.dd hh:mm:ss"));
+
+	return(true);
+}
+
+/**
+ * Set running without the window. Errors are printed to the standard error output instead of showing dialogs.
+ *
+ * @param enable Enable status
+ */
+void Emu::setHeadless(bool enable)
+{
+	this->headless = enable;
+}
+
+/**
+ * Set the emulated time after which the emulation is stopped and the application quits
+ *
+ * @param ms Emulated time in milliseconds, 0 runs forever
+ */
+void Emu::setExitTime(unsigned int ms)
+{
+	this->exitTicks = (static_cast<unsigned long long>(ms) * (CPU::FREQUENCY / 1000));
+}
+
+/**
+ * Set capturing of the presented LCD frames. The capture is finished when the application quits.
+ *
+ * @param textPath Path to the text dump, "-" is the standard output, empty path disables the dump
+ * @param textEveryFrame Write the text dump after every presented frame instead of only at the end
+ * @param recordPath Path to the directory for PNG frames, empty path disables the recording
+ *
+ * @return Status of opening the outputs
+ */
+bool Emu::setLCDCapture(const QString &textPath, bool textEveryFrame, const QString &recordPath)
+{
+	this->lcdCapture.reset(new LCDCapture());
+
+	if((!textPath.isEmpty()) && (!this->lcdCapture->setTextPath(textPath, textEveryFrame)))
+	{
+		this->lcdCapture.reset();
+
+		this->showError("Unable to open the LCD text dump file");
+		return(false);
+	}
+
+	if((!recordPath.isEmpty()) && (!this->lcdCapture->setRecordPath(recordPath)))
+	{
+		this->lcdCapture.reset();
+
+		this->showError("Unable to create the LCD record directory");
+		return(false);
+	}
+
+	QObject::connect(&this->io, SIGNAL(updateLCDCellsSignal(LCD::Cells)), this->lcdCapture.data(), SLOT(drawSlot(LCD::Cells)));
+	QObject::connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), this->lcdCapture.data(), SLOT(finishSlot()));
+
+	return(true);
+}
+
+/**
+ * Load all files needed for the emulation without dialogs
+ *
+ * @param urom0Path Path to the first uROM
+ * @param urom1Path Path to the second uROM
+ * @param biosPath Path to the BIOS
+ * @param fsPath Path to the file system directory
+ *
+ * @return Status of loading all files
+ */
+bool Emu::loadFiles(const QString &urom0Path, const QString &urom1Path, const QString &biosPath, const QString &fsPath)
+{
+	CPU::UROM urom0;
+	CPU::UROM urom1;
+	CPU::BIOS bios;
+
+	if((!this->loadUromFile(urom0Path, urom0)) || (!this->loadUromFile(urom1Path, urom1)) || (!this->loadBiosFile(biosPath, bios)))
+	{
+		return(false);
+	}
+
+	if(!QFileInfo(fsPath).isDir())
+	{
+		this->showError("Unable to open the file system directory");
+		return(false);
+	}
+
+	this->cpu.setUrom0(urom0);
+	this->cpu.setUrom1(urom1);
+	this->cpu.setBios(bios);
+	this->io.fsSetPath(fsPath);
+
+	this->ui->fileUrom0PathLabel->setText(urom0Path);
+	this->ui->fileUrom1PathLabel->setText(urom1Path);
+	this->ui->fileBiosPathLabel->setText(biosPath);
+	this->ui->fileFSDirPathLabel->setText(fsPath);
+
+	this->update();
+
+	return(this->loaded);
+}
+
+/**
+ * Start the emulation like the run button
+ *
+ * @return Status of starting, false when some files are not loaded
+ */
+bool Emu::start()
+{
+	if(!this->loaded)
+	{
+		return(false);
+	}
+
+	this->on_emuControlRunButton_clicked();
+
+	return(true);
+}
+
+/**
+ * Set path to the application binary to watch. When the file changes, the application is loaded to RAM and started without rebooting the machine.
+ *
+ * @param path Path to the application binary
+ */
+void Emu::setAppPath(const QString &path)
+{
+	if(!this->appPath.isEmpty())
+	{
+		this->appWatcher.removePath(this->appPath);
+	}
+
+	this->appPath = path;
+
+	if(!this->appPath.isEmpty())
+	{
+		this->appWatcher.addPath(this->appPath);
+	}
+}
+
+/**
+ * Start the server of the GDB Remote Serial Protocol on the local host
+ *
+ * @param port TCP port
+ *
+ * @return Status of starting the server
+ */
+bool Emu::setGDBPort(quint16 port)
+{
+	this->gdbServer.reset(new GDBServer(&this->cpu));
+
+	if(!this->gdbServer->listen(port))
+	{
+		this->gdbServer.reset();
+
+		this->showError("Unable to start the GDB server");
+		return(false);
+	}
+
+	QObject::connect(this->gdbServer.data(), SIGNAL(runningSignal(bool)), this, SLOT(gdbRunningSlot(bool)));
+
+	return(true);
+}
+
+/**
+ * Bridge the RS232 to a host program. The path used by the host program is printed.
+ *
+ * @param target "pty" opens a pseudo-terminal, any other value is a path of a local socket
+ *
+ * @return Status of opening the bridge
+ */
+bool Emu::setRS232Bridge(const QString &target)
+{
+	this->rs232Bridge.reset(new RS232Bridge(&this->io));
+
+	const bool opened = ((target == "pty") ? this->rs232Bridge->openPty() : this->rs232Bridge->listen(target));
+
+	if(!opened)
+	{
+		this->rs232Bridge.reset();
+
+		this->showError("Unable to open the RS232 bridge");
+		return(false);
+	}
+
+	qInfo("RS232 bridge: %s", qPrintable(this->rs232Bridge->getPath()));
+
+	return(true);
+}
+
+/**
+ * Start additional machines connected with this one by null-modem links. They run without windows on their own threads and use the same loaded files.
+ *
+ * @param machines Quantity of all machines including this one
+ * @param baud Speed of the links in bauds, 0 delivers bytes without a limit
+ *
+ * @return Status of starting the network
+ */
+bool Emu::setNetwork(int machines, int baud)
+{
+	if(!this->loaded)
+	{
+		this->showError("Load all files before starting the network");
+		return(false);
+	}
+
+	this->network.reset(new Network(&this->cpu, &this->io));
+
+	if(!this->network->start(machines, baud, this->ui->fileFSDirPathLabel->text()))
+	{
+		this->network.reset();
+
+		this->showError(QString("The network needs from 2 to %1 machines").arg(Network::MAX_MACHINES));
+		return(false);
+	}
+
+	return(true);
+}
+
+/**
+ * Set the script of the keyboard and RS232 input. It starts when the booted OS waits at its idle prompt, after the snapshot is restored or taken.
+ *
+ * @param path Path to the script file
+ *
+ * @return Status of loading the script
+ */
+bool Emu::setInputScript(const QString &path)
+{
+	QString error;
+
+	this->inputScript.reset(new InputScript(&this->cpu, &this->io));
+
+	if(!this->inputScript->load(path, error))
+	{
+		this->inputScript.reset();
+
+		this->showError(error);
+		return(false);
+	}
+
+	// Steps are executed inside the emulation step, so the results are processed after it
+	QObject::connect(this->inputScript.data(), SIGNAL(finishedSignal(unsigned long long)), this, SLOT(inputScriptFinishedSlot(unsigned long long)), Qt::QueuedConnection);
+	QObject::connect(this->inputScript.data(), SIGNAL(failedSignal(QString)), this, SLOT(inputScriptFailedSlot(QString)), Qt::QueuedConnection);
+	QObject::connect(this->inputScript.data(), SIGNAL(quitSignal()), QCoreApplication::instance(), SLOT(quit()), Qt::QueuedConnection);
+
+	return(true);
+}
+
+/**
+ * Add a map file written by the assembler. Its symbols are used to jump in the RAM view. The map file next to the BIOS is added automatically.
+ *
+ * @param path Path to the map file
+ *
+ * @return Status of reading the file
+ */
+bool Emu::addMapFile(const QString &path)
+{
+	SymbolMap symbols;
+
+	if(!symbols.load(path))
+	{
+		this->showError("Unable to open the map file");
+		return(false);
+	}
+
+	this->ramMapPaths.append(path);
+	this->ramLoadSymbols();
+
+	this->update();
+
+	return(true);
+}
+
+/**
+ * Save the state of the CPU and the IO
+ *
+ * @return State data
+ */
+QByteArray Emu::saveMachineState() const
+{
+	QByteArray state;
+	QDataStream stream(&state, QIODevice::WriteOnly);
+
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	this->cpu.saveState(stream);
+	this->io.saveState(stream);
+
+	return(state);
+}
+
+/**
+ * Load the state of the CPU and the IO
+ *
+ * @param state State data
+ *
+ * @return Status of loading the state
+ */
+bool Emu::loadMachineState(const QByteArray &state)
+{
+	QDataStream stream(state);
+
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	if((!this->cpu.loadState(stream)) || (!this->io.loadState(stream)))
+	{
+		this->cpu.stop();
+		this->io.reset();
+
+		return(false);
+	}
+
+	return(true);
+}
+
+//! Restore the snapshot of the idle OS for the current loaded files or prepare to take it
+void Emu::snapshotRestore()
+{
+	this->snapshotPending = false;
+
+	if(!this->snapshotEnabled)
+	{
+		return;
+	}
+
+	this->snapshotKey = SnapshotCache::createKey(this->cpu.getUrom0(), this->cpu.getUrom1(), this->cpu.getBios(), this->ui->fileFSDirPathLabel->text());
+
+	QByteArray state;
+
+	if(this->snapshotCache.load(this->snapshotKey, state))
+	{
+		if(this->loadMachineState(state))
+		{
+			return;
+		}
+
+		this->snapshotCache.remove(this->snapshotKey);
+	}
+
+	this->snapshotPending = true;
+}
+
+/**
+ * Take the snapshot when the OS reaches its idle prompt
+ *
+ * @param idle Status of the idle prompt at the end of the emulation step
+ */
+void Emu::snapshotCheck(bool idle)
+{
+	if(this->snapshotPending && idle)
+	{
+		this->snapshotCache.save(this->snapshotKey, this->saveMachineState());
+		this->snapshotPending = false;
+	}
+}
 
-	QObject::connect(&this->io, SIGNAL(updateRTCDateTimeSignal(QDateTime)), this, SLOT(updateRTCDateTimeSlot(QDateTime)));
+/**
+ * Check if the OS waits at its idle prompt. It is detected as a whole running emulation step without any IO operation after loading the OS,
+ * with no pending events and a silent speaker. It must be called once at the end of every emulation step.
+ *
+ * @return Status of the idle prompt
+ */
+bool Emu::idleCheck()
+{
+	const unsigned long long operations = this->io.getOperations();
+	const bool idle = (this->running && this->io.isOSLoaded() && (operations == this->idleOperations) && (!this->io.speakerIsPlaying()) && (this->cpu.getScheduler().getNextTick() == Scheduler::NO_EVENT));
 
-	QObject::connect(&this->io, SIGNAL(updateSpeakerStatusSignal(int)), this, SLOT(updateSpeakerStatusSlot(int)));
+	this->idleOperations = operations;
 
-	QObject::connect(&this->cpu, SIGNAL(outSignal(unsigned char)), &this->io, SLOT(outSlot(unsigned char)));
-	QObject::connect(&this->io, SIGNAL(inSignal(unsigned char)), &this->cpu, SLOT(inSlot(unsigned char)));
+	return(idle);
 }
 
-//! Destructor for the emulator class
-Emu::~Emu()
+/**
+ * Check if a reloaded file has changed. A changed content invalidates the snapshot of the current loaded files.
+ *
+ * @param path Path to the loaded file
+ * @param data Content of the loaded file
+ */
+void Emu::checkFileContent(const QString &path, const QByteArray &data)
 {
-	QObject::disconnect(&this->io);
-	QObject::disconnect(&this->cpu);
+	QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha256);
 
-	QObject::disconnect(this);
+	if(this->fileHashes.contains(path) && (this->fileHashes.value(path) != hash) && (!this->snapshotKey.isEmpty()))
+	{
+		this->snapshotCache.remove(this->snapshotKey);
+		this->snapshotKey.clear();
+	}
 
-	delete ui;
+	this->fileHashes.insert(path, hash);
 }
 
 //! Reset the UI elements
@@ -131,18 +683,21 @@ void Emu::reset()
 	this->ui->ledErrorValueLabel->setText("");
 	this->ui->ledErrorValueLabel->setStyleSheet("");
 
-	this->ramSetPage(0);
+	this->ramShowAddress(0);
+
+	this->rs232ViewTimer.stop();
+	this->rs232TxPending.clear();
+	this->rs232RxPending.clear();
 
 	this->ui->rs232RxText->clear();
 	this->ui->rs232TxText->clear();
 	this->ui->rs232RxEdit->clear();
 
-	QDateTime dateTime;
-	dateTime.setDate(QDate(2000, 1, 1));
-
-	this->ui->rtcValueLabel->setText(dateTime.toString("yyyy.MM.dd hh:mm:ss"));
+	this->ui->rtcValueLabel->setText(this->io.rtcGetDateTime().toString("yyyy.MM.dd hh:mm:ss"));
 
 	this->ui->speakerBufferValueLabel->setText("0");
+
+	this->viewValid = false;
 }
 
 //! Update internal statuses and UI elements
@@ -201,6 +756,23 @@ void Emu::update()
 	this->ui->ramGoToOSButton->setEnabled(this->started);
 	this->ui->ramGoToAppButton->setEnabled(this->started);
 	this->ui->ramGoToSPButton->setEnabled(this->started);
+	this->ui->ramSymbolBox->setEnabled(this->started && (this->ui->ramSymbolBox->count() > 0));
+
+	this->ramModel.setEnabled(this->started);
+	this->ramUpdate();
+
+	// The view pulls the state at its own rate, so the quantity of emulation steps per second does not matter
+	if(this->started && (!this->headless))
+	{
+		if(!this->viewTimer.isActive())
+		{
+			this->viewTimer.start();
+		}
+	}
+	else
+	{
+		this->viewTimer.stop();
+	}
 
 	this->ui->rs232RxSendButton->setEnabled(this->started);
 	this->ui->rtcSetCurrentButton->setEnabled(this->started);
@@ -208,68 +780,70 @@ void Emu::update()
 }
 
 /**
- * Set RAM page to show
+ * Scroll the RAM view to show the address in the top row and select it
  *
- * @param page Page number
+ * @param address Memory address
  */
-void Emu::ramSetPage(int page)
+void Emu::ramShowAddress(int address)
 {
-	if((page >= 0) && ((CPU::MEMORY_SIZE / CPU::MEMORY_PAGE_SIZE) > page))
+	if((address >= 0) && (address < CPU::MEMORY_SIZE))
 	{
-		this->ramPage = page;
+		QModelIndex index = this->ramModel.index((address / RAMModel::COLUMNS), (address % RAMModel::COLUMNS));
 
-		this->ui->ramText->clear();
+		this->ui->ramView->scrollTo(index, QAbstractItemView::PositionAtTop);
+		this->ui->ramView->setCurrentIndex(index);
+	}
 
-		if(this->started)
-		{
-			const QVector<unsigned char> *memory;
+	this->ramUpdate();
+}
 
-			if((page * CPU::MEMORY_PAGE_SIZE) < CPU::BIOS_SIZE)
-			{
-				memory = &(this->cpu.getBios().data);
-			}
-			else
-			{
-				memory = &(this->cpu.getRam().data);
-			}
+//! Update bytes, the address range and the page buttons of the RAM view. Only rows visible in the view are read.
+void Emu::ramUpdate()
+{
+	const int firstRow = qMax(0, this->ui->ramView->rowAt(0));
+	int lastRow = this->ui->ramView->rowAt(this->ui->ramView->viewport()->height() - 1);
 
-			QString text = "";
+	if(lastRow < 0)
+	{
+		lastRow = (RAMModel::ROWS - 1);
+	}
 
-			for(int i = 0; i < CPU::MEMORY_PAGE_SIZE; i++)
-			{
-				if(((i % 16) == 0) && (i != 0))
-				{
-					text.append("\n");
-				}
-				else if((i % 16) != 0)
-				{
-					text.append(" ");
-				}
-
-				text.append(QString("%1").arg(memory->at((this->ramPage * CPU::MEMORY_PAGE_SIZE) + i), 2, 16, QChar('0')));
-			}
+	this->ramModel.refresh(firstRow, lastRow);
 
-			this->ui->ramText->setPlainText(text);
+	this->ui->ramMinusButton->setEnabled(this->started && (firstRow > 0));
+	this->ui->ramPlusButton->setEnabled(this->started && (lastRow < (RAMModel::ROWS - 1)));
 
-			this->ui->ramMinusButton->setEnabled(page != 0);
-			this->ui->ramPlusButton->setEnabled(page < ((CPU::MEMORY_SIZE / CPU::MEMORY_PAGE_SIZE) - 1));
-		}
-		else
-		{
-			this->ui->ramMinusButton->setEnabled(false);
-			this->ui->ramPlusButton->setEnabled(false);
-		}
+	QString firstAddress = QString("%1").arg((firstRow * RAMModel::COLUMNS), 4, 16, QChar('0')).toUpper();
+	QString lastAddress = QString("%1").arg(((lastRow * RAMModel::COLUMNS) + (RAMModel::COLUMNS - 1)), 4, 16, QChar('0')).toUpper();
+
+	this->ui->ramAddressLabel->setText(QString("%1 - %2").arg(firstAddress, lastAddress));
+}
+
+//! Read symbols from the map file next to the BIOS and from the additional map files again, and fill the symbol list of the RAM view
+void Emu::ramLoadSymbols()
+{
+	this->ramSymbols.clear();
+
+	if((!this->ramBiosMapPath.isEmpty()) && QFileInfo(this->ramBiosMapPath).isFile())
+	{
+		this->ramSymbols.load(this->ramBiosMapPath);
+	}
+
+	for(const QString &path : qAsConst(this->ramMapPaths))
+	{
+		this->ramSymbols.load(path);
 	}
 
-	QString addressPrefix = QString("%1").arg(this->ramPage, 2, 16, QChar('0')).toUpper();
-	QString address = "";
+	this->ui->ramSymbolBox->clear();
+
+	const QMap<QString, int> &symbols = this->ramSymbols.getSymbols();
 
-	address.append(addressPrefix);
-	address.append("00 - ");
-	address.append(addressPrefix);
-	address.append("FF");
+	for(auto i = symbols.constBegin(); i != symbols.constEnd(); ++i)
+	{
+		this->ui->ramSymbolBox->addItem(i.key(), i.value());
+	}
 
-	this->ui->ramAddressLabel->setText(QString().append(address));
+	this->ui->ramSymbolBox->setCurrentIndex(-1);
 }
 
 /**
@@ -286,18 +860,20 @@ bool Emu::loadUromFile(const QString &path, CPU::UROM &urom)
 
 	if(!file.open(QIODevice::ReadOnly))
 	{
-		QMessageBox::critical(this, "Error", "Unable to open file");
+		this->showError("Unable to open file");
 		return(false);
 	}
 
 	if(CPU::UROM_SIZE != file.read(reinterpret_cast<char *>(urom.data.data()), CPU::UROM_SIZE))
 	{
-		QMessageBox::critical(this, "Error", "Bad size of file");
+		this->showError("Bad size of file");
 		return(false);
 	}
 
 	file.close();
 
+	this->checkFileContent(path, QByteArray::fromRawData(reinterpret_cast<const char *>(urom.data.constData()), CPU::UROM_SIZE));
+
 	return(true);
 }
 
@@ -315,21 +891,46 @@ bool Emu::loadBiosFile(const QString &path, CPU::BIOS &bios)
 
 	if(!file.open(QIODevice::ReadOnly))
 	{
-		QMessageBox::critical(this, "Error", "Unable to open file");
+		this->showError("Unable to open file");
 		return(false);
 	}
 
 	if(CPU::BIOS_SIZE != file.read(reinterpret_cast<char *>(bios.data.data()), CPU::BIOS_SIZE))
 	{
-		QMessageBox::critical(this, "Error", "Bad size of file");
+		this->showError("Bad size of file");
 		return(false);
 	}
 
 	file.close();
 
+	this->checkFileContent(path, QByteArray::fromRawData(reinterpret_cast<const char *>(bios.data.constData()), CPU::BIOS_SIZE));
+
+	// The assembler writes the map of the BIOS next to it with the same name
+	QFileInfo fileInfo(path);
+
+	this->ramBiosMapPath = fileInfo.dir().filePath(fileInfo.completeBaseName() + ".map");
+	this->ramLoadSymbols();
+
 	return(true);
 }
 
+/**
+ * Show an error message. In the headless mode it is printed to the standard error output.
+ *
+ * @param message Error message
+ */
+void Emu::showError(const QString &message)
+{
+	if(this->headless)
+	{
+		qCritical("Error: %s", qPrintable(message));
+	}
+	else
+	{
+		QMessageBox::critical(this, "Error", message);
+	}
+}
+
 /**
  * Process the mouse press event
  *
@@ -361,76 +962,170 @@ void Emu::keyPressEvent(QKeyEvent *event)
 {
 	if(this->running)
 	{
+		// A typed key changes the way to the idle prompt
+		this->snapshotPending = false;
+
 		this->io.keyboardKeyPress(event->key(), event->modifiers());
 	}
 }
 
-//! Update time, registers, memory view UI elements
+/**
+ * Set labels of a register
+ *
+ * @param hexLabel Label of the hex value
+ * @param decLabel Label of the decimal value, it can be null
+ * @param binLabel Label of the binary value
+ * @param value Value of the register
+ */
+void Emu::viewSetRegister(QLabel *hexLabel, QLabel *decLabel, QLabel *binLabel, unsigned char value)
+{
+	hexLabel->setText(QString("%1").arg(value, 2, 16, QChar('0')));
+
+	if(decLabel != nullptr)
+	{
+		decLabel->setText(QString("%1").arg(value));
+	}
+
+	binLabel->setText(QString("%1").arg(value, 8, 2, QChar('0')));
+}
+
+//! Process the end of an emulation step
+void Emu::stepSlot()
+{
+	if((this->exitTicks > 0) && (this->cpu.getTicks() >= this->exitTicks))
+	{
+		this->on_emuControlPauseButton_clicked();
+
+		QCoreApplication::quit();
+	}
+
+	const bool idle = this->idleCheck();
+
+	this->snapshotCheck(idle);
+
+	// The script starts from the idle prompt of the booted OS after the snapshot is taken, whether the boot was emulated or restored
+	if(this->inputScriptPending && (!this->snapshotPending) && idle)
+	{
+		this->inputScriptPending = false;
+		this->inputScript->start();
+	}
+}
+
+//! Update time, registers, memory view UI elements. The state is compared with the shown one and only labels of changed values are formatted again.
 void Emu::updateSlot()
 {
-	unsigned long long ticks = this->cpu.getTicks();
+	const bool all = (!this->viewValid);
+
+	const unsigned long long ms = (this->cpu.getTicks() / (CPU::FREQUENCY / 1000));
+
+	if(all || (ms != this->viewMs))
+	{
+		QString timeMs = QString("%1").arg((ms % 1000), 3, 10, QChar('0'));
+		QString timeSec = QString("%1").arg(((ms / 1000) % 60), 2, 10, QChar('0'));
+		QString timeMin = QString("%1").arg(((ms / (60 * 1000)) % 60), 2, 10, QChar('0'));
+		QString timeHour = QString("%1").arg((ms / (60 * 1000) / 60), 2, 10, QChar('0'));
+
+		this->ui->emuTimeValueLabel->setText(QString("%1:%2:%3.%4").arg(timeHour, timeMin, timeSec, timeMs));
+
+		this->viewMs = ms;
+	}
+
+	const QDateTime rtc = this->io.rtcGetDateTime();
 
-	QString timeMs = QString("%1").arg(((ticks / (CPU::FREQUENCY / 1000)) % 1000), 3, 10, QChar('0'));
-	QString timeSec = QString("%1").arg(((ticks / CPU::FREQUENCY) % 60), 2, 10, QChar('0'));
-	QString timeMin = QString("%1").arg(((ticks / (60 * CPU::FREQUENCY)) % 60), 2, 10, QChar('0'));
-	QString timeHour = QString("%1").arg(((ticks / (60 * CPU::FREQUENCY) / 60)), 2, 10, QChar('0'));
+	if(all || ((rtc.toMSecsSinceEpoch() / 1000) != this->viewRTC))
+	{
+		this->ui->rtcValueLabel->setText(rtc.toString("yyyy.MM.dd hh:mm:ss"));
 
-	this->ui->emuTimeValueLabel->setText(QString("%1:%2:%3.%4").arg(timeHour, timeMin, timeSec, timeMs));
+		this->viewRTC = (rtc.toMSecsSinceEpoch() / 1000);
+	}
 
 	const CPU::Reg &reg = this->cpu.getReg();
+	const CPU::Reg &shown = this->viewReg;
+
+	if(all || (reg.a != shown.a))
+	{
+		this->viewSetRegister(this->ui->regAValueHexLabel, this->ui->regAValueDecLabel, this->ui->regAValueBinLabel, reg.a);
+	}
+
+	if(all || (reg.b != shown.b))
+	{
+		this->viewSetRegister(this->ui->regBValueHexLabel, this->ui->regBValueDecLabel, this->ui->regBValueBinLabel, reg.b);
+	}
 
-	this->ui->regAValueHexLabel->setText(QString("%1").arg(reg.a, 2, 16, QChar('0')));
-	this->ui->regAValueDecLabel->setText(QString("%1").arg(reg.a));
-	this->ui->regAValueBinLabel->setText(QString("%1").arg(reg.a, 8, 2, QChar('0')));
+	if(all || (reg.x != shown.x))
+	{
+		this->viewSetRegister(this->ui->regXValueHexLabel, this->ui->regXValueDecLabel, this->ui->regXValueBinLabel, reg.x);
+	}
 
-	this->ui->regBValueHexLabel->setText(QString("%1").arg(reg.b, 2, 16, QChar('0')));
-	this->ui->regBValueDecLabel->setText(QString("%1").arg(reg.b));
-	this->ui->regBValueBinLabel->setText(QString("%1").arg(reg.b, 8, 2, QChar('0')));
+	if(all || (reg.y != shown.y))
+	{
+		this->viewSetRegister(this->ui->regYValueHexLabel, this->ui->regYValueDecLabel, this->ui->regYValueBinLabel, reg.y);
+	}
 
-	this->ui->regXValueHexLabel->setText(QString("%1").arg(reg.x, 2, 16, QChar('0')));
-	this->ui->regXValueDecLabel->setText(QString("%1").arg(reg.x));
-	this->ui->regXValueBinLabel->setText(QString("%1").arg(reg.x, 8, 2, QChar('0')));
+	if(all || (reg.in != shown.in))
+	{
+		this->viewSetRegister(this->ui->regINValueHexLabel, this->ui->regINValueDecLabel, this->ui->regINValueBinLabel, reg.in);
+	}
 
-	this->ui->regYValueHexLabel->setText(QString("%1").arg(reg.y, 2, 16, QChar('0')));
-	this->ui->regYValueDecLabel->setText(QString("%1").arg(reg.y));
-	this->ui->regYValueBinLabel->setText(QString("%1").arg(reg.y, 8, 2, QChar('0')));
+	if(all || (reg.out != shown.out))
+	{
+		this->viewSetRegister(this->ui->regOUTValueHexLabel, this->ui->regOUTValueDecLabel, this->ui->regOUTValueBinLabel, reg.out);
+	}
 
-	this->ui->regINValueHexLabel->setText(QString("%1").arg(reg.in, 2, 16, QChar('0')));
-	this->ui->regINValueDecLabel->setText(QString("%1").arg(reg.in));
-	this->ui->regINValueBinLabel->setText(QString("%1").arg(reg.in, 8, 2, QChar('0')));
+	if(all || (reg.d != shown.d))
+	{
+		this->viewSetRegister(this->ui->regDValueHexLabel, this->ui->regDValueDecLabel, this->ui->regDValueBinLabel, reg.d);
+	}
 
-	this->ui->regOUTValueHexLabel->setText(QString("%1").arg(reg.out, 2, 16, QChar('0')));
-	this->ui->regOUTValueDecLabel->setText(QString("%1").arg(reg.out));
-	this->ui->regOUTValueBinLabel->setText(QString("%1").arg(reg.out, 8, 2, QChar('0')));
+	if(all || (reg.t != shown.t))
+	{
+		this->viewSetRegister(this->ui->regTValueHexLabel, this->ui->regTValueDecLabel, this->ui->regTValueBinLabel, reg.t);
+	}
 
-	this->ui->regDValueHexLabel->setText(QString("%1").arg(reg.d, 2, 16, QChar('0')));
-	this->ui->regDValueDecLabel->setText(QString("%1").arg(reg.d));
-	this->ui->regDValueBinLabel->setText(QString("%1").arg(reg.d, 8, 2, QChar('0')));
+	if(all || (reg.i != shown.i))
+	{
+		this->viewSetRegister(this->ui->regIValueHexLabel, nullptr, this->ui->regIValueBinLabel, reg.i);
+	}
 
-	this->ui->regTValueHexLabel->setText(QString("%1").arg(reg.t, 2, 16, QChar('0')));
-	this->ui->regTValueDecLabel->setText(QString("%1").arg(reg.t));
-	this->ui->regTValueBinLabel->setText(QString("%1").arg(reg.t, 8, 2, QChar('0')));
+	if(all || (reg.pch != shown.pch) || (reg.pcl != shown.pcl))
+	{
+		this->ui->regPCHValueLabel->setText(QString("%1").arg(reg.pch, 2, 16, QChar('0')));
+		this->ui->regPCLValueLabel->setText(QString("%1").arg(reg.pcl, 2, 16, QChar('0')));
+	}
 
-	this->ui->regIValueHexLabel->setText(QString("%1").arg(reg.i, 2, 16, QChar('0')));
-	this->ui->regIValueBinLabel->setText(QString("%1").arg(reg.i, 8, 2, QChar('0')));
+	if(all || (reg.c != shown.c))
+	{
+		this->ui->regCValueLabel->setText(QString("%1%2").arg(static_cast<int>(reg.c[1])).arg(static_cast<int>(reg.c[0])));
+	}
 
-	this->ui->regPCHValueLabel->setText(QString("%1").arg(reg.pch, 2, 16, QChar('0')));
-	this->ui->regPCLValueLabel->setText(QString("%1").arg(reg.pcl, 2, 16, QChar('0')));
+	if(all || (reg.z != shown.z))
+	{
+		this->ui->regZValueLabel->setText(QString("%1%2").arg(static_cast<int>(reg.z[1])).arg(static_cast<int>(reg.z[0])));
+	}
 
-	this->ui->regCValueLabel->setText(QString("%1%2").arg(static_cast<int>(reg.c[1])).arg(static_cast<int>(reg.c[0])));
-	this->ui->regZValueLabel->setText(QString("%1%2").arg(static_cast<int>(reg.z[1])).arg(static_cast<int>(reg.z[0])));
+	if(all || (reg.sph != shown.sph) || (reg.spl != shown.spl) || (reg.maxSp != shown.maxSp))
+	{
+		this->ui->regSPHValueLabel->setText(QString("%1").arg(reg.sph, 2, 16, QChar('0')));
+		this->ui->regSPLValueLabel->setText(QString("%1").arg(reg.spl, 2, 16, QChar('0')));
+		this->ui->regSPMaxValueLabel->setText(QString("%1").arg(reg.maxSp, 4, 16, QChar('0')));
+	}
 
-	this->ui->regSPHValueLabel->setText(QString("%1").arg(reg.sph, 2, 16, QChar('0')));
-	this->ui->regSPLValueLabel->setText(QString("%1").arg(reg.spl, 2, 16, QChar('0')));
-	this->ui->regSPMaxValueLabel->setText(QString("%1").arg(reg.maxSp, 4, 16, QChar('0')));
+	if(all || (reg.bph != shown.bph) || (reg.bpl != shown.bpl))
+	{
+		this->ui->regBPHValueLabel->setText(QString("%1").arg(reg.bph, 2, 16, QChar('0')));
+		this->ui->regBPLValueLabel->setText(QString("%1").arg(reg.bpl, 2, 16, QChar('0')));
+	}
 
-	this->ui->regBPHValueLabel->setText(QString("%1").arg(reg.bph, 2, 16, QChar('0')));
-	this->ui->regBPLValueLabel->setText(QString("%1").arg(reg.bpl, 2, 16, QChar('0')));
+	if(all || (reg.mah != shown.mah) || (reg.mal != shown.mal))
+	{
+		this->ui->regMAHValueLabel->setText(QString("%1").arg(reg.mah, 2, 16, QChar('0')));
+		this->ui->regMALValueLabel->setText(QString("%1").arg(reg.mal, 2, 16, QChar('0')));
+	}
 
-	this->ui->regMAHValueLabel->setText(QString("%1").arg(reg.mah, 2, 16, QChar('0')));
-	this->ui->regMALValueLabel->setText(QString("%1").arg(reg.mal, 2, 16, QChar('0')));
+	this->viewReg = reg;
+	this->viewValid = true;
 
-	this->ramSetPage(this->ramPage);
+	this->ramUpdate();
 }
 
 /**
@@ -456,51 +1151,88 @@ void Emu::updateLEDErrorSlot(bool enable)
 }
 
 /**
- * Update status of transmited data via RS232
+ * Update status of transmited data via RS232. The text is collected and appended to the view by the view timer.
  *
- * @param c Transmited char
+ * @param data Transmited chars collected since the previous update
  */
-void Emu::updateRS232TxSlot(unsigned char c)
+void Emu::updateRS232TxSlot(const QByteArray &data)
 {
-	this->ui->rs232TxText->moveCursor(QTextCursor::End);
+	QByteArray text = data;
 
-	if(c != 0)
-	{
-		this->ui->rs232TxText->insertPlainText(QString(c));
-	}
-	else
+	this->rs232TxPending.append(QString::fromLatin1(text.replace('\0', '\n')));
+
+	if(!this->rs232ViewTimer.isActive())
 	{
-		this->ui->rs232TxText->insertPlainText("\n");
+		this->rs232ViewTimer.start();
 	}
+}
+
+/**
+ * Update status of received data via RS232. The text is collected and appended to the view by the view timer.
+ *
+ * @param data Received chars collected since the previous update
+ */
+void Emu::updateRS232RxSlot(const QByteArray &data)
+{
+	QByteArray text = data;
 
-	QScrollBar *scrollBar = this->ui->rs232TxText->verticalScrollBar();
+	this->rs232RxPending.append(QString::fromLatin1(text.replace('\0', '\n')));
 
-	scrollBar->setValue(scrollBar->maximum());
+	if(!this->rs232ViewTimer.isActive())
+	{
+		this->rs232ViewTimer.start();
+	}
 }
 
 /**
- * Update status of received data via RS232
+ * Append the collected text to the RS232 view with one insert and scroll it to the end
  *
- * @param c Received char
+ * @param view RS232 view
+ * @param pending Collected text, it is cleared
  */
-void Emu::updateRS232RxSlot(unsigned char c)
+void Emu::rs232FlushView(QPlainTextEdit *view, QString &pending)
 {
-	this->ui->rs232RxText->moveCursor(QTextCursor::End);
-
-	if(c != 0)
+	if(pending.isEmpty())
 	{
-		this->ui->rs232RxText->insertPlainText(QString(c));
+		return;
 	}
-	else
+
+	// Text not fitting in the view would be removed at once by the maximum block count
+	if(pending.count('\n') > RS232_VIEW_LINES)
 	{
-		this->ui->rs232RxText->insertPlainText("\n");
+		int pos = pending.size();
+
+		for(int i = 0; i < RS232_VIEW_LINES; i++)
+		{
+			pos = pending.lastIndexOf('\n', (pos - 1));
+		}
+
+		pending.remove(0, (pos + 1));
 	}
 
-	QScrollBar *scrollBar = this->ui->rs232RxText->verticalScrollBar();
+	view->moveCursor(QTextCursor::End);
+	view->insertPlainText(pending);
+
+	pending.clear();
+
+	QScrollBar *scrollBar = view->verticalScrollBar();
 
 	scrollBar->setValue(scrollBar->maximum());
 }
 
+//! Append the collected RS232 text to both views. It is called at most once per view interval, so a fast transmission does not block the window.
+void Emu::rs232ViewSlot()
+{
+	this->rs232FlushView(this->ui->rs232TxText, this->rs232TxPending);
+	this->rs232FlushView(this->ui->rs232RxText, this->rs232RxPending);
+}
+
+//! Process scrolling of the RAM view
+void Emu::ramScrolledSlot()
+{
+	this->ramUpdate();
+}
+
 /**
  * Update status of date and time
  *
@@ -511,6 +1243,17 @@ void Emu::updateRTCDateTimeSlot(const QDateTime &dateTime)
 	this->ui->rtcValueLabel->setText(dateTime.toString("yyyy.MM.dd hh:mm:ss"));
 }
 
+/**
+ * Update status of the LCD frames
+ *
+ * @param submitted Quantity of refreshes requested by the guest
+ * @param presented Quantity of frames shown on the LCD view
+ */
+void Emu::updateLCDFramesSlot(unsigned long long submitted, unsigned long long presented)
+{
+	this->ui->lcdFramesValueLabel->setText(QString("%1 / %2").arg(presented).arg(submitted));
+}
+
 /**
  * Update status of the speaker buffer usage
  *
@@ -521,6 +1264,92 @@ void Emu::updateSpeakerStatusSlot(int bufferUsed)
 	this->ui->speakerBufferValueLabel->setText(QString("%1").arg(bufferUsed));
 }
 
+//! Process a change of the watched application binary. The reload is delayed until the assembler finishes writing the file.
+void Emu::appChangedSlot()
+{
+	this->appReloadTimer.start();
+}
+
+//! Load the changed application binary to RAM and start it
+void Emu::appReloadSlot()
+{
+	// Some tools replace the file instead of writing it, so the watcher loses it
+	if(!this->appWatcher.files().contains(this->appPath))
+	{
+		this->appWatcher.addPath(this->appPath);
+	}
+
+	if(!this->started)
+	{
+		return;
+	}
+
+	QFile file(this->appPath);
+
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		return;
+	}
+
+	QByteArray app = file.readAll();
+
+	file.close();
+
+	if(this->cpu.startApp(app))
+	{
+		// The old code may have been stopped between the halves of a byte
+		this->io.resetTransfer();
+		this->io.speakerClear();
+		this->io.ledSetError(false);
+
+		this->updateSlot();
+	}
+}
+
+/**
+ * Process a change of the emulation status made by the debugger
+ *
+ * @param running Status of running the emulation
+ */
+void Emu::gdbRunningSlot(bool running)
+{
+	this->started = true;
+	this->running = running;
+
+	this->update();
+
+	// The view is refreshed only when the target stops, not after every step of the debugger
+	if(!running)
+	{
+		this->updateSlot();
+	}
+}
+
+/**
+ * Process the end of the input script
+ *
+ * @param ticks CPU clock ticks from the start of the script
+ */
+void Emu::inputScriptFinishedSlot(unsigned long long ticks)
+{
+	qInfo("Input script finished after %llu ms of the emulated time", (ticks / (CPU::FREQUENCY / 1000)));
+}
+
+/**
+ * Process a failed wait of the input script. In the headless mode the application quits with an error.
+ *
+ * @param message Error message
+ */
+void Emu::inputScriptFailedSlot(const QString &message)
+{
+	this->showError(message);
+
+	if(this->headless)
+	{
+		QCoreApplication::exit(1);
+	}
+}
+
 //! Process first uROM open event
 void Emu::on_fileUrom0OpenButton_clicked()
 {
@@ -662,6 +1491,14 @@ void Emu::on_fileBiosReloadButton_clicked()
 //! Process run emulation event
 void Emu::on_emuControlRunButton_clicked()
 {
+	if(!this->started)
+	{
+		this->snapshotRestore();
+
+		this->idleOperations = 0;
+		this->inputScriptPending = (!this->inputScript.isNull());
+	}
+
 	this->started = true;
 	this->running = true;
 
@@ -673,6 +1510,14 @@ void Emu::on_emuControlRunButton_clicked()
 //! Process a make step emulation event
 void Emu::on_emuControlStepButton_clicked()
 {
+	if(!this->started)
+	{
+		this->snapshotPending = false;
+
+		this->idleOperations = 0;
+		this->inputScriptPending = (!this->inputScript.isNull());
+	}
+
 	this->started = true;
 
 	this->update();
@@ -699,6 +1544,13 @@ void Emu::on_emuControlStopButton_clicked()
 	this->cpu.stop();
 	this->io.reset();
 
+	this->inputScriptPending = false;
+
+	if(this->inputScript)
+	{
+		this->inputScript->reset();
+	}
+
 	this->reset();
 	this->update();
 }
@@ -726,37 +1578,54 @@ void Emu::on_rtcSetCurrentButton_clicked()
 //! Process go to the BIOS section for RAM event
 void Emu::on_ramGoToBIOSButton_clicked()
 {
-	this->ramSetPage(CPU::MEMORY_BIOS_ADDRESS / CPU::MEMORY_PAGE_SIZE);
+	this->ramShowAddress(CPU::MEMORY_BIOS_ADDRESS);
 }
 
 //! Process go to the OS section for RAM event
 void Emu::on_ramGoToOSButton_clicked()
 {
-	this->ramSetPage(CPU::MEMORY_OS_ADDRESS / CPU::MEMORY_PAGE_SIZE);
+	this->ramShowAddress(CPU::MEMORY_OS_ADDRESS);
 }
 
 //! Process go to the application section for RAM event
 void Emu::on_ramGoToAppButton_clicked()
 {
-	this->ramSetPage(CPU::MEMORY_APP_ADDRESS / CPU::MEMORY_PAGE_SIZE);
+	this->ramShowAddress(CPU::MEMORY_APP_ADDRESS);
 }
 
 //! Process go to the Stack section for RAM event
 void Emu::on_ramGoToSPButton_clicked()
 {
-	this->ramSetPage(CPU::MEMORY_SP_ADDRESS / CPU::MEMORY_PAGE_SIZE);
+	this->ramShowAddress(CPU::MEMORY_SP_ADDRESS);
 }
 
 //! Process go to the previous page for RAM event
 void Emu::on_ramMinusButton_clicked()
 {
-	this->ramSetPage(this->ramPage - 1);
+	const int page = ((qMax(0, this->ui->ramView->rowAt(0)) * RAMModel::COLUMNS) / CPU::MEMORY_PAGE_SIZE);
+
+	this->ramShowAddress(qMax(0, (page - 1)) * CPU::MEMORY_PAGE_SIZE);
 }
 
 //! Process go to the next page for RAM event
 void Emu::on_ramPlusButton_clicked()
 {
-	this->ramSetPage(this->ramPage + 1);
+	const int page = ((qMax(0, this->ui->ramView->rowAt(0)) * RAMModel::COLUMNS) / CPU::MEMORY_PAGE_SIZE);
+
+	this->ramShowAddress((page + 1) * CPU::MEMORY_PAGE_SIZE);
+}
+
+/**
+ * Process the choice of a symbol for RAM event
+ *
+ * @param index Index of the symbol in the list
+ */
+void Emu::on_ramSymbolBox_activated(int index)
+{
+	if(index >= 0)
+	{
+		this->ramShowAddress(this->ui->ramSymbolBox->itemData(index).toInt());
+	}
 }
 
 //! Process send the transmit buffer data via RS232 event
@@ -766,5 +1635,7 @@ void Emu::on_rs232RxSendButton_clicked()
 
 	this->ui->rs232RxEdit->clear();
 
+	this->snapshotPending = false;
+
 	this->io.rs232Receive(text);
 }
@@ -15,13 +15,34 @@
 #include <QMainWindow>
 #include <QFileDialog>
 #include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QCoreApplication>
 #include <QMessageBox>
 #include <QMouseEvent>
 #include <QKeyEvent>
 #include <QScrollBar>
+#include <QPlainTextEdit>
+#include <QLabel>
+#include <QMap>
+#include <QStringList>
+#include <QByteArray>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QScopedPointer>
 
 #include "cpu.h"
 #include "io.h"
+#include "rammodel.h"
+#include "symbolmap.h"
+#include "snapshotcache.h"
+#include "gdbserver.h"
+#include "rs232bridge.h"
+#include "network.h"
+#include "inputscript.h"
+#include "lcdcapture.h"
 
 //! User Interface namespace
 namespace Ui
@@ -42,14 +63,52 @@ class Emu : public QMainWindow
 		Emu(Emu &&) = delete;
 		Emu &operator=(Emu &&) = delete;
 
+		void setIOLatency(bool enable);
+		bool setIOLatencyTable(const QString &path);
+		void setSnapshotEnabled(bool enable);
+		void setAppPath(const QString &path);
+		void setLCDFPS(int fps);
+		void setSpeakerBandLimited(bool enable);
+		void setAudioDeviceEnabled(bool enable);
+		bool setAudioWavPath(const QString &path);
+		void setHeadless(bool enable);
+		bool setRTC(bool wall, const QString &epoch);
+		void setExitTime(unsigned int ms);
+		bool setLCDCapture(const QString &textPath, bool textEveryFrame, const QString &recordPath);
+
+		bool loadFiles(const QString &urom0Path, const QString &urom1Path, const QString &biosPath, const QString &fsPath);
+		bool start();
+		bool setGDBPort(quint16 port);
+		bool setRS232Bridge(const QString &target);
+		bool setNetwork(int machines, int baud);
+		bool setInputScript(const QString &path);
+		bool addMapFile(const QString &path);
+
+		QByteArray saveMachineState() const;
+		bool loadMachineState(const QByteArray &state);
+
 	private:
 		void reset();
 		void update();
 
 		bool loadUromFile(const QString &path, CPU::UROM &urom);
 		bool loadBiosFile(const QString &path, CPU::BIOS &bios);
+		void checkFileContent(const QString &path, const QByteArray &data);
+
+		void showError(const QString &message);
+
+		void snapshotRestore();
+		void snapshotCheck(bool idle);
+
+		bool idleCheck();
+
+		void ramShowAddress(int address);
+		void ramUpdate();
+		void ramLoadSymbols();
+
+		void rs232FlushView(QPlainTextEdit *view, QString &pending);
 
-		void ramSetPage(int page);
+		void viewSetRegister(QLabel *hexLabel, QLabel *decLabel, QLabel *binLabel, unsigned char value);
 
 		void mousePressEvent(QMouseEvent *event) override;
 		bool focusNextPrevChild(bool next) override;
@@ -65,21 +124,78 @@ class Emu : public QMainWindow
 		CPU cpu; //!< CPU instance for emulating the processor
 		IO io; //!< IO instance for emulating the motherboard
 
-		int ramPage; //!< Number of the RAM page to show
+		RAMModel ramModel; //!< Model of the whole memory shown in the RAM view
+		SymbolMap ramSymbols; //!< Symbols used to jump in the RAM view
+		QString ramBiosMapPath; //!< Path to the map file next to the loaded BIOS
+		QStringList ramMapPaths; //!< Paths to the additional map files
+
+		SnapshotCache snapshotCache; //!< Cache of the machine states taken when the OS reaches its idle prompt
+		QByteArray snapshotKey; //!< Key of the snapshot for the current loaded files
+		QMap<QString, QByteArray> fileHashes; //!< Hashes of the loaded uROM and BIOS files used to detect a changed content
+		bool snapshotEnabled; //!< Status of using the snapshot cache
+		bool snapshotPending; //!< Status of waiting for the idle prompt to take a snapshot
+		unsigned long long idleOperations; //!< Counter of IO operations at the previous emulation step
+
+		static const int APP_RELOAD_DELAY = 200; //!< Time in milliseconds to wait after the last change of the watched application before reloading it
+
+		QString appPath; //!< Path to the watched application binary
+		QFileSystemWatcher appWatcher; //!< Watcher of the application binary
+		QTimer appReloadTimer; //!< Timer used to reload the application after the last change
+
+		static const int RS232_VIEW_INTERVAL = 33; //!< Time in milliseconds between appends of the collected RS232 text to the views
+		static const int RS232_VIEW_LINES = 1000; //!< Maximum quantity of lines kept in the RS232 views, older lines are removed
+
+		QString rs232TxPending; //!< Transmitted text waiting for the append to the view
+		QString rs232RxPending; //!< Received text waiting for the append to the view
+		QTimer rs232ViewTimer; //!< Timer used to append the collected RS232 text at most once per interval
+
+		static const int VIEW_INTERVAL = 33; //!< Time in milliseconds between updates of the time, registers and memory view, about 30 times per second
+
+		QTimer viewTimer; //!< Timer used to pull the state of the machine to the view while the emulation is started
+		bool viewValid; //!< Status of showing the values below, it is false after a reset and all labels are set again
+		unsigned long long viewMs; //!< Shown emulated time in milliseconds
+		qint64 viewRTC; //!< Shown RTC time in seconds since the epoch
+		CPU::Reg viewReg; //!< Shown registers
+
+		QScopedPointer<GDBServer> gdbServer; //!< Server of the GDB Remote Serial Protocol
+		QScopedPointer<RS232Bridge> rs232Bridge; //!< Bridge of the RS232 to a host pseudo-terminal or a local socket
+		QScopedPointer<Network> network; //!< Additional machines connected by null-modem links
+
+		QScopedPointer<InputScript> inputScript; //!< Script of the keyboard and RS232 input
+		bool inputScriptPending; //!< Status of waiting for the booted OS to start the input script
+
+		bool headless; //!< Status of running without the window, errors are printed instead of showing dialogs
+		unsigned long long exitTicks; //!< Emulated time in ticks after which the application quits, 0 runs forever
+		QScopedPointer<LCDCapture> lcdCapture; //!< Capture of the presented LCD frames
 
 	private slots:
+		void stepSlot();
 		void updateSlot();
 
 		void updateLEDRunSlot(bool enable);
 		void updateLEDErrorSlot(bool enable);
 
-		void updateRS232TxSlot(unsigned char c);
-		void updateRS232RxSlot(unsigned char c);
+		void updateRS232TxSlot(const QByteArray &data);
+		void updateRS232RxSlot(const QByteArray &data);
 
 		void updateRTCDateTimeSlot(const QDateTime &dateTime);
 
+		void updateLCDFramesSlot(unsigned long long submitted, unsigned long long presented);
+
 		void updateSpeakerStatusSlot(int bufferUsed);
 
+		void appChangedSlot();
+		void appReloadSlot();
+
+		void rs232ViewSlot();
+
+		void ramScrolledSlot();
+
+		void gdbRunningSlot(bool running);
+
+		void inputScriptFinishedSlot(unsigned long long ticks);
+		void inputScriptFailedSlot(const QString &message);
+
 		void on_fileUrom0OpenButton_clicked();
 		void on_fileUrom1OpenButton_clicked();
 		void on_fileBiosOpenButton_clicked();
@@ -104,6 +220,7 @@ class Emu : public QMainWindow
 		void on_ramGoToSPButton_clicked();
 		void on_ramMinusButton_clicked();
 		void on_ramPlusButton_clicked();
+		void on_ramSymbolBox_activated(int index);
 
 		void on_rs232RxSendButton_clicked();
 };
@@ -1,4 +1,4 @@
-QT += core gui widgets multimedia
+QT += core gui widgets multimedia network
 
 CONFIG += c++14
 
@@ -6,32 +6,68 @@ DEFINES += QT_DEPRECATED_WARNINGS
 CONFIG -= debug_and_release debug_and_release_target
 
 SOURCES += \
+    audiooutput.cpp \
+    audioring.cpp \
+    audiostream.cpp \
+    bytering.cpp \
     cpu.cpp \
     fs.cpp \
+    gdbserver.cpp \
+    inputscript.cpp \
     io.cpp \
     keyboard.cpp \
     lcd.cpp \
+    lcdcapture.cpp \
+    lcdrecorder.cpp \
+    lcdrenderer.cpp \
     lcdview.cpp \
     led.cpp \
     main.cpp \
+    network.cpp \
+    networknode.cpp \
+    nullmodem.cpp \
     emu.cpp \
+    rammodel.cpp \
     rs232.cpp \
+    rs232bridge.cpp \
     rtc.cpp \
-    speaker.cpp
+    scheduler.cpp \
+    snapshotcache.cpp \
+    speaker.cpp \
+    symbolmap.cpp \
+    wavwriter.cpp
 
 HEADERS += \
+    audiooutput.h \
+    audioring.h \
+    audiostream.h \
+    bytering.h \
     cpu.h \
     emu.h \
     font.h \
     fs.h \
+    gdbserver.h \
+    inputscript.h \
     io.h \
     keyboard.h \
     lcd.h \
+    lcdcapture.h \
+    lcdrecorder.h \
+    lcdrenderer.h \
     lcdview.h \
     led.h \
+    network.h \
+    networknode.h \
+    nullmodem.h \
+    rammodel.h \
     rs232.h \
+    rs232bridge.h \
     rtc.h \
-    speaker.h
+    scheduler.h \
+    snapshotcache.h \
+    speaker.h \
+    symbolmap.h \
+    wavwriter.h
 
 FORMS += \
     emu.ui
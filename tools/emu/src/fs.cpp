@@ -9,8 +9,14 @@
  * Code is free for non-commercial and commercial use.
  */
 
+#include <cstring>
+
 #include "fs.h"
 
+const QRegularExpression FS::FILE_PATH_REGEX(R"(^(([0-9a-zA-Z_-]{1,8})/)?([0-9a-zA-Z_-]{1,8})(([\\.])([0-9a-zA-Z_-]{1,3}))?$)");
+const QRegularExpression FS::DIR_PATH_REGEX("^([0-9a-zA-Z_-]{1,8})$");
+const QRegularExpression FS::FILE_NAME_REGEX(R"(^([0-9a-zA-Z_-]{1,8})(([\\.])([0-9a-zA-Z_-]{1,3}))?$)");
+
 /**
  * Constructor for the file system class
  *
@@ -19,15 +25,94 @@
 FS::FS(QObject *parent) : QObject(parent)
 {
 	this->path = "";
+	this->map = nullptr;
+
+	QObject::connect(&this->watcher, SIGNAL(directoryChanged(QString)), this, SLOT(dirChangedSlot(QString)));
+	QObject::connect(&this->watcher, SIGNAL(fileChanged(QString)), this, SLOT(fileChangedSlot(QString)));
 
 	this->reset();
 }
 
+//! Destructor for the file system class
+FS::~FS()
+{
+	this->close();
+}
+
 //! Reset the file system buffers and path
 void FS::reset()
 {
+	this->close();
+}
+
+//! Close the open file and clear the data buffer
+void FS::close()
+{
+	if(this->map != nullptr)
+	{
+		this->file.unmap(this->map);
+		this->map = nullptr;
+	}
+
+	this->file.close();
+	this->filePath.clear();
+
 	this->data.clear();
+	this->dataStart = 0;
+	this->dataSize = 0;
 	this->dataPos = 0;
+
+	this->blockStart = 0;
+	this->blockEnd = 0;
+}
+
+/**
+ * Open a file from the emulated file system. Files up to the maximum file size are copied, so the host can rewrite them while they are read.
+ * Larger files opened as streams are mapped to memory. If mapping is not possible, they are read through the read-ahead window.
+ *
+ * @param path Path to the file relative to the emulated file system
+ *
+ * @return Status of the open operation
+ */
+bool FS::openFile(const QString &path)
+{
+	this->close();
+
+	this->file.setFileName(QString(this->path).append("/").append(path));
+
+	if(!this->file.open(QIODevice::ReadOnly))
+	{
+		return(false);
+	}
+
+	this->filePath = path;
+	this->dataSize = static_cast<int>(qMin(this->file.size(), static_cast<qint64>(STREAM_MAX_SIZE)));
+
+	if(this->dataSize <= FILE_MAX_SIZE)
+	{
+		this->data = this->file.read(this->dataSize);
+		this->dataSize = this->data.size();
+	}
+	else
+	{
+		// A mapped file must not be truncated by the host while it is open, reading a removed page stops the emulator
+		this->map = this->file.map(0, this->dataSize);
+	}
+
+	return(true);
+}
+
+/**
+ * Write the value to the size struct
+ *
+ * @param value Size value
+ * @param size Struct where size will be written
+ */
+void FS::setSize(int value, FS::Size &size)
+{
+	size.low = static_cast<unsigned char>(value % 256);
+	size.high = static_cast<unsigned char>((value / 256) & 0xff);
+	size.ext = static_cast<unsigned char>((value / 65536) & 0xff);
 }
 
 /**
@@ -38,55 +123,48 @@ void FS::reset()
 void FS::setPath(const QString &path)
 {
 	this->path = path;
+
+	this->clearListCache();
 }
 
 /**
- * Open and load to buffer a file from the emulated file system
+ * Open a file from the emulated file system to read it
  *
  * @param path Path to a file
  * @param size Struct where size of the file will be written
+ * @param maxSize Maximum size of the file
  *
  * @return Status of the open operation
  */
-bool FS::open(const QString &path, FS::Size &size)
+bool FS::open(const QString &path, FS::Size &size, int maxSize)
 {
-	size.low = 0;
-	size.high = 0;
+	setSize(0, size);
 
-	if(!path.contains(QRegularExpression("^(([0-9a-zA-Z_-]{1,8})/)?([0-9a-zA-Z_-]{1,8})(([\\\\.])([0-9a-zA-Z_-]{1,3}))?$")))
+	if(!path.contains(FILE_PATH_REGEX))
 	{
 		return(false);
 	}
 
-	QString filePath = QString(this->path).append("/").append(path);
-	QFile file(filePath);
-
-	if(!file.open(QIODevice::ReadOnly))
+	if(QFileInfo(QString(this->path).append("/").append(path)).size() > maxSize)
 	{
+		this->close();
+
 		return(false);
 	}
 
-	if(file.size() > FILE_MAX_SIZE)
+	if(!this->openFile(path))
 	{
-		file.close();
-
 		return(false);
 	}
 
-	this->data = file.readAll();
-
-	file.close();
-
-	this->dataPos = 0;
-
-	size.low = static_cast<unsigned char>(this->data.size() % 256);
-	size.high = static_cast<unsigned char>((this->data.size() / 256) & 0xff);
+	setSize(this->dataSize, size);
 
 	return(true);
 }
 
 /**
- * Create a list of files in the directory from the emulated file system
+ * Create a list of files in the directory from the emulated file system.
+ * The encoded list is cached until the watcher reports a change of the directory or one of the listed files.
  *
  * @param path Path to a directory
  * @param size Struct where size of the buffer with description of the files will be written
@@ -95,28 +173,61 @@ bool FS::open(const QString &path, FS::Size &size)
  */
 bool FS::list(const QString &path, FS::Size &size)
 {
-	size.low = 0;
-	size.high = 0;
+	setSize(0, size);
 
-	if(!path.contains(QRegularExpression("^([0-9a-zA-Z_-]{1,8})$")))
+	if(!path.contains(DIR_PATH_REGEX))
 	{
 		return(false);
 	}
 
-	QString dirPath = QString(this->path).append("/").append(path);
-	QDir dir;
+	QString dirPath = QDir::cleanPath(QString(this->path).append("/").append(path));
+	QHash<QString, QByteArray>::const_iterator cached = this->listCache.constFind(dirPath);
+	QByteArray list;
 
-	dir.setFilter(QDir::Files | QDir::NoDotAndDotDot);
-	dir.setSorting(QDir::Name);
-
-	if(!dir.cd(dirPath))
+	if(cached != this->listCache.constEnd())
 	{
-		return(false);
+		list = cached.value();
+	}
+	else
+	{
+		if(!QFileInfo(dirPath).isDir())
+		{
+			return(false);
+		}
+
+		list = this->createList(dirPath);
 	}
 
+	this->close();
+
+	this->data = list;
+	this->dataSize = this->data.size();
+
+	setSize(this->dataSize, size);
+
+	return(true);
+}
+
+/**
+ * Scan the directory on the local disk and encode the list of its files.
+ * The list is added to the cache if the directory can be watched, otherwise it is scanned again on every list operation.
+ *
+ * @param dirPath Path to the directory on the local disk
+ *
+ * @return Encoded list, DIR_ENTRY_SIZE bytes per file
+ */
+QByteArray FS::createList(const QString &dirPath)
+{
+	QDir dir(dirPath);
+
+	dir.setFilter(QDir::Files | QDir::NoDotAndDotDot);
+	dir.setSorting(QDir::Name);
+
 	QFileInfoList fileInfoList = dir.entryInfoList();
+	QStringList filePaths;
+	QByteArray list;
 
-	this->data.clear();
+	list.reserve(DIR_MAX_QUANTITY * DIR_ENTRY_SIZE);
 
 	for(const QFileInfo &fileInfo : fileInfoList)
 	{
@@ -128,45 +239,141 @@ bool FS::list(const QString &path, FS::Size &size)
 			continue;
 		}
 
-		if(!fileName.contains(QRegularExpression(R"(^([0-9a-zA-Z_-]{1,8})(([\\.])([0-9a-zA-Z_-]{1,3}))?$)")))
+		if(!fileName.contains(FILE_NAME_REGEX))
 		{
 			continue;
 		}
 
-		int j = 0;
+		QByteArray name = fileName.toLatin1();
+		char entry[DIR_ENTRY_SIZE];
+
+		std::memset(entry, 0, DIR_ENTRY_SIZE);
+		std::memcpy(entry, name.constData(), static_cast<size_t>(qMin(name.size(), NAME_MAX_LENGTH)));
+
+		entry[DIR_ENTRY_SIZE - DIR_SIZE_FIELD_SIZE] = static_cast<char>(fileSize % 256);
+		entry[DIR_ENTRY_SIZE - DIR_SIZE_FIELD_SIZE + 1] = static_cast<char>((fileSize / 256) & 0xff);
+
+		list.append(entry, DIR_ENTRY_SIZE);
+		filePaths.append(fileInfo.filePath());
 
-		for(; ((j < NAME_MAX_LENGTH) && (j < fileName.length())); j++)
+		if(list.size() >= (DIR_MAX_QUANTITY * DIR_ENTRY_SIZE))
 		{
-			this->data.append(fileName.at(j).toLatin1());
+			break;
 		}
+	}
 
-		for(; j < (DIR_ENTRY_SIZE - DIR_SIZE_FIELD_SIZE); j++)
+	if(this->watcher.addPath(dirPath))
+	{
+		if(!filePaths.isEmpty())
 		{
-			this->data.append(static_cast<char>(0));
+			this->watcher.addPaths(filePaths);
 		}
 
-		QVector<unsigned char> size(2);
+		this->listCache.insert(dirPath, list);
+	}
+
+	return(list);
+}
 
-		size[0] = static_cast<unsigned char>(fileSize % 256);
-		size[1] = static_cast<unsigned char>((fileSize / 256) & 0xff);
+//! Drop all cached lists and stop watching their directories
+void FS::clearListCache()
+{
+	this->listCache.clear();
 
-		this->data.append(static_cast<char>(size[0]));
-		this->data.append(static_cast<char>(size[1]));
+	if(!this->watcher.directories().isEmpty())
+	{
+		this->watcher.removePaths(this->watcher.directories());
+	}
 
-		if(this->data.size() >= (DIR_MAX_QUANTITY * DIR_ENTRY_SIZE))
+	if(!this->watcher.files().isEmpty())
+	{
+		this->watcher.removePaths(this->watcher.files());
+	}
+}
+
+/**
+ * Drop the cached list of the changed directory. The directory and its files are watched again when it is listed next time.
+ *
+ * @param path Path to the changed directory on the local disk
+ */
+void FS::dirChangedSlot(const QString &path)
+{
+	this->listCache.remove(path);
+
+	QStringList paths(path);
+	QString prefix = QString(path).append("/");
+
+	for(const QString &filePath : this->watcher.files())
+	{
+		if(filePath.startsWith(prefix))
 		{
-			break;
+			paths.append(filePath);
 		}
 	}
 
-	this->dataPos = 0;
+	this->watcher.removePaths(paths);
+}
 
-	size.low = static_cast<unsigned char>(this->data.size() % 256);
-	size.high = static_cast<unsigned char>((this->data.size() / 256) & 0xff);
+/**
+ * Drop the cached list of the directory with the changed file
+ *
+ * @param path Path to the changed file on the local disk
+ */
+void FS::fileChangedSlot(const QString &path)
+{
+	this->dirChangedSlot(path.left(path.lastIndexOf('/')));
+}
+
+/**
+ * Set the read position of the open file or list
+ *
+ * @param offset Offset from the beginning of the data
+ *
+ * @return Status of the seek operation, it fails when the offset is beyond the end of the data
+ */
+bool FS::seek(int offset)
+{
+	if((offset < 0) || (offset > this->dataSize))
+	{
+		return(false);
+	}
+
+	this->dataPos = offset;
 
 	return(true);
 }
 
+/**
+ * Read the next block of the open file ahead, as the IO board does with the read block command.
+ * The data is already mapped or windowed, so only the range of the block is remembered. It is used by the processing time model.
+ *
+ * @return Status of the read block operation, it fails when no file is open
+ */
+bool FS::readBlock()
+{
+	this->blockStart = this->dataPos;
+	this->blockEnd = this->dataPos;
+
+	if(this->filePath.isEmpty())
+	{
+		return(false);
+	}
+
+	this->blockEnd = qMin((this->dataPos + BLOCK_SIZE), this->dataSize);
+
+	return(true);
+}
+
+/**
+ * Check if the next byte is inside the block read ahead
+ *
+ * @return Status of the next byte in the block
+ */
+bool FS::isInBlock() const
+{
+	return((this->dataPos >= this->blockStart) && (this->dataPos < this->blockEnd));
+}
+
 /**
  * Get next byte from the buffer
  *
@@ -174,14 +381,90 @@ bool FS::list(const QString &path, FS::Size &size)
  */
 unsigned char FS::readNextDataByte()
 {
-	unsigned char data = 0;
+	if(this->dataPos >= this->dataSize)
+	{
+		return(0);
+	}
 
-	if(this->data.length() > this->dataPos)
+	if(this->map != nullptr)
 	{
-		data = static_cast<unsigned char>(this->data.at(this->dataPos));
+		return(this->map[this->dataPos++]);
+	}
+
+	if(this->file.isOpen() && ((this->dataPos < this->dataStart) || (this->dataPos >= (this->dataStart + this->data.size()))))
+	{
+		this->file.seek(this->dataPos);
 
-		this->dataPos++;
+		this->data = this->file.read(WINDOW_SIZE);
+		this->dataStart = this->dataPos;
+
+		if(this->data.isEmpty())
+		{
+			return(0);
+		}
 	}
 
+	unsigned char data = static_cast<unsigned char>(this->data.at(this->dataPos - this->dataStart));
+
+	this->dataPos++;
+
 	return(data);
 }
+
+/**
+ * Save the open file or the list, the read pointer and the range of the block read ahead to the state stream. The path is a configuration, so it is not saved.
+ * The open file is saved as its path and opened again when the state is loaded.
+ *
+ * @param stream State stream
+ */
+void FS::saveState(QDataStream &stream) const
+{
+	stream << this->filePath;
+
+	if(this->filePath.isEmpty())
+	{
+		stream << this->data;
+	}
+
+	stream << this->dataPos << this->blockStart << this->blockEnd;
+}
+
+/**
+ * Load the open file or the list, the read pointer and the range of the block read ahead from the state stream
+ *
+ * @param stream State stream
+ */
+void FS::loadState(QDataStream &stream)
+{
+	QString filePath;
+	QByteArray data;
+	int dataPos = 0;
+	int blockStart = 0;
+	int blockEnd = 0;
+
+	stream >> filePath;
+
+	if(filePath.isEmpty())
+	{
+		stream >> data;
+	}
+
+	stream >> dataPos >> blockStart >> blockEnd;
+
+	this->close();
+
+	if(filePath.isEmpty())
+	{
+		this->data = data;
+		this->dataSize = data.size();
+	}
+	else
+	{
+		this->openFile(filePath);
+	}
+
+	this->seek(dataPos);
+
+	this->blockStart = blockStart;
+	this->blockEnd = blockEnd;
+}
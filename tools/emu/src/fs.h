@@ -14,12 +14,17 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QByteArray>
 #include <QVector>
 #include <QFile>
 #include <QDir>
+#include <QFileInfo>
 #include <QFileInfoList>
 #include <QRegularExpression>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QDataStream>
 
 //! This class contains file system functions
 class FS : public QObject
@@ -34,6 +39,10 @@ class FS : public QObject
 		static const int DIR_MAX_QUANTITY = 64; //!< Maximum quantity of files in directory
 
 		static const int FILE_MAX_SIZE = 53248; //!< Maximum size of the file
+		static const int STREAM_MAX_SIZE = 0xffffff; //!< Maximum size of the file opened as a stream, it is read in parts with seeking
+
+		static const int WINDOW_SIZE = 4096; //!< Size of the read-ahead window used when the file cannot be mapped
+		static const int BLOCK_SIZE = 256; //!< Size of the block read ahead by the read block command of the IO board
 
 		static const int MIN_CODE = 0x20; //!< Minimum correctly character code
 		static const int MAX_CODE = 0x7e; //!< Maximum correctly character code
@@ -43,23 +52,65 @@ class FS : public QObject
 		{
 			unsigned char low; //!< Lower byte of the size
 			unsigned char high; //!< Higher byte of the size
+			unsigned char ext; //!< Extended byte of the size, bits 16-23
 		};
 
 		FS(QObject *parent = nullptr);
+		~FS() override;
+
+		FS(const FS &) = delete;
+		FS &operator=(const FS &) = delete;
+		FS(FS &&) = delete;
+		FS &operator=(FS &&) = delete;
 
 		void reset();
 
+		void saveState(QDataStream &stream) const;
+		void loadState(QDataStream &stream);
+
 		void setPath(const QString &path);
 
-		bool open(const QString &path, FS::Size &size);
+		bool open(const QString &path, FS::Size &size, int maxSize);
 		bool list(const QString &path, FS::Size &size);
+		bool seek(int offset);
+		bool readBlock();
+		bool isInBlock() const;
 
 		unsigned char readNextDataByte();
 
 	private:
+		static const QRegularExpression FILE_PATH_REGEX; //!< Regular expression of a correct path to a file
+		static const QRegularExpression DIR_PATH_REGEX; //!< Regular expression of a correct path to a directory
+		static const QRegularExpression FILE_NAME_REGEX; //!< Regular expression of a correct name of a listed file
+
 		QString path; //!< Path to the emulated file system on the local disk
-		QByteArray data; //!< Buffer used to loading whole file or a list with description of the files
+
+		QHash<QString, QByteArray> listCache; //!< Encoded lists of the directories, the key is the directory path on the local disk
+		QFileSystemWatcher watcher; //!< Watcher of the cached directories and their files, any change drops the cached list
+
+		QString filePath; //!< Path of the open file relative to the emulated file system, empty for a list
+		QFile file; //!< Open file
+		uchar *map; //!< Content of the open file mapped to memory, nullptr when mapping is not possible
+
+		QByteArray data; //!< List with description of the files or the read-ahead window of the open file
+		int dataStart; //!< Offset of the first byte of the data buffer in the open file
+		int dataSize; //!< Size of the open file or the list
 		int dataPos; //!< Position of the data read pointer
+
+		int blockStart; //!< Position of the first byte of the block read ahead
+		int blockEnd; //!< Position after the last byte of the block read ahead, it is equal to the start when there is no block
+
+		bool openFile(const QString &path);
+		void close();
+
+		QByteArray createList(const QString &dirPath);
+		void clearListCache();
+
+		static void setSize(int value, FS::Size &size);
+
+	private slots:
+		void dirChangedSlot(const QString &path);
+		void fileChangedSlot(const QString &path);
 };
 
 #endif
@@ -0,0 +1,557 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "gdbserver.h"
+
+/**
+ * Constructor for the GDB server class
+ *
+ * @param cpu Debugged CPU
+ * @param parent Parent object
+ */
+GDBServer::GDBServer(CPU *cpu, QObject *parent) : QObject(parent)
+{
+	this->cpu = cpu;
+	this->running = false;
+
+	QObject::connect(&this->server, SIGNAL(newConnection()), this, SLOT(newConnectionSlot()));
+	QObject::connect(this->cpu, SIGNAL(breakpointSignal()), this, SLOT(breakpointSlot()));
+}
+
+//! Destructor for the GDB server class
+GDBServer::~GDBServer()
+{
+	QObject::disconnect(this);
+}
+
+/**
+ * Start listening for the debugger on the local host
+ *
+ * @param port TCP port
+ *
+ * @return Status of starting the server
+ */
+bool GDBServer::listen(quint16 port)
+{
+	return(this->server.listen(QHostAddress::LocalHost, port));
+}
+
+/**
+ * Process a single packet received from the debugger
+ *
+ * @param packet Packet data without the frame and the checksum
+ */
+void GDBServer::processPacket(const QByteArray &packet)
+{
+	if(packet.isEmpty())
+	{
+		this->sendPacket("");
+		return;
+	}
+
+	QByteArray args = packet.mid(1);
+
+	switch(packet.at(0))
+	{
+		case '?' :
+			this->sendStop(SIGNAL_TRAP);
+			break;
+
+		case 'g' :
+			this->sendPacket(this->readRegisters());
+			break;
+
+		case 'p' :
+			this->sendPacket(this->readRegister(args.toInt(nullptr, 16)));
+			break;
+
+		case 'm' :
+			this->sendPacket(this->readMemory(args));
+			break;
+
+		case 'M' :
+			this->sendPacket(this->writeMemory(args));
+			break;
+
+		case 'Z' :
+			this->sendPacket(this->setBreakpoint(args, true));
+			break;
+
+		case 'z' :
+			this->sendPacket(this->setBreakpoint(args, false));
+			break;
+
+		case 'c' :
+			// The answer is sent when the target stops
+			this->resume();
+			break;
+
+		case 's' :
+			this->cpu->stepInstruction();
+			this->sendStop(SIGNAL_TRAP);
+			break;
+
+		case 'H' :
+			this->sendPacket("OK");
+			break;
+
+		case 'k' :
+			this->stop();
+			this->socket->disconnectFromHost();
+			break;
+
+		case 'D' :
+			this->sendPacket("OK");
+			this->cpu->clearBreakpoints();
+			this->resume();
+			this->running = false;
+			this->socket->disconnectFromHost();
+			break;
+
+		case 'q' :
+			if(packet.startsWith("qSupported"))
+			{
+				this->sendPacket(QByteArray("PacketSize=").append(QByteArray::number(PACKET_SIZE, 16)).append(";qXfer:features:read+"));
+			}
+			else if(packet.startsWith("qXfer:features:read:"))
+			{
+				this->sendPacket(this->readFeatures(packet.mid(static_cast<int>(qstrlen("qXfer:features:read:")))));
+			}
+			else if(packet == "qAttached")
+			{
+				this->sendPacket("1");
+			}
+			else
+			{
+				this->sendPacket("");
+			}
+			break;
+
+		default :
+			// Not supported packets get an empty answer
+			this->sendPacket("");
+			break;
+	}
+}
+
+/**
+ * Send a packet to the debugger
+ *
+ * @param data Packet data
+ */
+void GDBServer::sendPacket(const QByteArray &data)
+{
+	if(this->socket.isNull())
+	{
+		return;
+	}
+
+	unsigned char checksum = 0;
+
+	for(char c : data)
+	{
+		checksum = static_cast<unsigned char>(checksum + static_cast<unsigned char>(c));
+	}
+
+	QByteArray frame;
+
+	frame.append('$');
+	frame.append(data);
+	frame.append('#');
+	frame.append(QByteArray::number(checksum, 16).rightJustified(2, '0'));
+
+	this->socket->write(frame);
+}
+
+/**
+ * Send a stop reply to the debugger
+ *
+ * @param signal Number of the signal which stopped the target
+ */
+void GDBServer::sendStop(int signal)
+{
+	this->sendPacket(QByteArray("S").append(QByteArray::number(signal, 16).rightJustified(2, '0')));
+}
+
+/**
+ * Read a single register in the format of the target description
+ *
+ * @param number Number of the register
+ *
+ * @return Hex encoded value of the register, little-endian
+ */
+QByteArray GDBServer::readRegister(int number) const
+{
+	const CPU::Reg &reg = this->cpu->getReg();
+	QByteArray value;
+
+	switch(number)
+	{
+		case REG_A :
+			value.append(static_cast<char>(reg.a));
+			break;
+
+		case REG_B :
+			value.append(static_cast<char>(reg.b));
+			break;
+
+		case REG_X :
+			value.append(static_cast<char>(reg.x));
+			break;
+
+		case REG_Y :
+			value.append(static_cast<char>(reg.y));
+			break;
+
+		case REG_FLAGS :
+			value.append(static_cast<char>((reg.c[0] ? 0x01 : 0) | (reg.c[1] ? 0x02 : 0) | (reg.z[0] ? 0x04 : 0) | (reg.z[1] ? 0x08 : 0)));
+			break;
+
+		case REG_PC :
+			value.append(static_cast<char>(reg.pcl));
+			value.append(static_cast<char>(reg.pch));
+			break;
+
+		case REG_SP :
+			value.append(static_cast<char>(reg.spl));
+			value.append(static_cast<char>(reg.sph));
+			break;
+
+		case REG_BP :
+			value.append(static_cast<char>(reg.bpl));
+			value.append(static_cast<char>(reg.bph));
+			break;
+
+		default :
+			return("E01");
+	}
+
+	return(value.toHex());
+}
+
+/**
+ * Read all registers in the format of the target description
+ *
+ * @return Hex encoded values of the registers
+ */
+QByteArray GDBServer::readRegisters() const
+{
+	QByteArray data;
+
+	for(int i = 0; i < REG_QUANTITY; i++)
+	{
+		data.append(this->readRegister(i));
+	}
+
+	return(data);
+}
+
+/**
+ * Read memory of the CPU
+ *
+ * @param args Arguments of the packet in format "address,length"
+ *
+ * @return Hex encoded memory or an error
+ */
+QByteArray GDBServer::readMemory(const QByteArray &args) const
+{
+	QList<QByteArray> fields = args.split(',');
+
+	if(fields.size() != 2)
+	{
+		return("E01");
+	}
+
+	bool addressOk = false;
+	bool lengthOk = false;
+
+	int address = fields.at(0).toInt(&addressOk, 16);
+	int length = fields.at(1).toInt(&lengthOk, 16);
+
+	if((!addressOk) || (!lengthOk) || (address < 0) || (length < 0) || ((address + length) > CPU::MEMORY_SIZE) || ((length * 2) > PACKET_SIZE))
+	{
+		return("E01");
+	}
+
+	QByteArray data;
+
+	for(int i = 0; i < length; i++)
+	{
+		data.append(static_cast<char>(this->cpu->readMemory(address + i)));
+	}
+
+	return(data.toHex());
+}
+
+/**
+ * Write memory of the CPU
+ *
+ * @param args Arguments of the packet in format "address,length:data"
+ *
+ * @return Status of the operation
+ */
+QByteArray GDBServer::writeMemory(const QByteArray &args)
+{
+	int separator = args.indexOf(':');
+
+	if(separator < 0)
+	{
+		return("E01");
+	}
+
+	QList<QByteArray> fields = args.left(separator).split(',');
+	QByteArray data = QByteArray::fromHex(args.mid(separator + 1));
+
+	if(fields.size() != 2)
+	{
+		return("E01");
+	}
+
+	bool addressOk = false;
+	bool lengthOk = false;
+
+	int address = fields.at(0).toInt(&addressOk, 16);
+	int length = fields.at(1).toInt(&lengthOk, 16);
+
+	if((!addressOk) || (!lengthOk) || (address < 0) || (length != data.size()) || ((address + length) > CPU::MEMORY_SIZE))
+	{
+		return("E01");
+	}
+
+	for(int i = 0; i < length; i++)
+	{
+		this->cpu->writeMemory((address + i), static_cast<unsigned char>(data.at(i)));
+	}
+
+	return("OK");
+}
+
+/**
+ * Set or remove a breakpoint. Software and hardware breakpoints are the same for the emulator.
+ *
+ * @param args Arguments of the packet in format "type,address,kind"
+ * @param enable Status of the breakpoint
+ *
+ * @return Status of the operation or an empty answer for not supported types
+ */
+QByteArray GDBServer::setBreakpoint(const QByteArray &args, bool enable)
+{
+	QList<QByteArray> fields = args.split(',');
+
+	if((fields.size() < 2) || ((fields.at(0) != "0") && (fields.at(0) != "1")))
+	{
+		return("");
+	}
+
+	bool addressOk = false;
+	int address = fields.at(1).toInt(&addressOk, 16);
+
+	if((!addressOk) || (address < 0) || (address >= CPU::MEMORY_SIZE))
+	{
+		return("E01");
+	}
+
+	this->cpu->setBreakpoint(address, enable);
+
+	return("OK");
+}
+
+/**
+ * Read a part of the target description
+ *
+ * @param args Arguments of the packet in format "annex:offset,length"
+ *
+ * @return Part of the description with the "m" prefix or the last part with the "l" prefix
+ */
+QByteArray GDBServer::readFeatures(const QByteArray &args) const
+{
+	static const QByteArray targetXml =
+		"<?xml version=\"1.0\"?>"
+		"<!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+		"<target version=\"1.0\">"
+		"<feature name=\"net.xirx.xipu.core\">"
+		"<reg name=\"a\" bitsize=\"8\" type=\"uint8\" regnum=\"0\"/>"
+		"<reg name=\"b\" bitsize=\"8\" type=\"uint8\"/>"
+		"<reg name=\"x\" bitsize=\"8\" type=\"uint8\"/>"
+		"<reg name=\"y\" bitsize=\"8\" type=\"uint8\"/>"
+		"<reg name=\"flags\" bitsize=\"8\" type=\"uint8\"/>"
+		"<reg name=\"pc\" bitsize=\"16\" type=\"code_ptr\"/>"
+		"<reg name=\"sp\" bitsize=\"16\" type=\"data_ptr\"/>"
+		"<reg name=\"bp\" bitsize=\"16\" type=\"data_ptr\"/>"
+		"</feature>"
+		"</target>";
+
+	int separator = args.indexOf(':');
+
+	if((separator < 0) || (args.left(separator) != "target.xml"))
+	{
+		return("E00");
+	}
+
+	QList<QByteArray> fields = args.mid(separator + 1).split(',');
+
+	if(fields.size() != 2)
+	{
+		return("E01");
+	}
+
+	int offset = fields.at(0).toInt(nullptr, 16);
+	int length = fields.at(1).toInt(nullptr, 16);
+
+	if(offset >= targetXml.size())
+	{
+		return("l");
+	}
+
+	QByteArray part = targetXml.mid(offset, length);
+
+	return(QByteArray(((offset + part.size()) >= targetXml.size()) ? "l" : "m").append(part));
+}
+
+//! Continue executing the emulation until a breakpoint or an interrupt from the debugger
+void GDBServer::resume()
+{
+	this->running = true;
+
+	this->cpu->run();
+
+	emit runningSignal(true);
+}
+
+//! Pause executing the emulation
+void GDBServer::stop()
+{
+	this->running = false;
+
+	this->cpu->pause();
+
+	emit runningSignal(false);
+}
+
+//! Accept a new debugger. Only one debugger can be connected at the same time. The target is stopped after connecting.
+void GDBServer::newConnectionSlot()
+{
+	QTcpSocket *socket = this->server.nextPendingConnection();
+
+	if(!this->socket.isNull())
+	{
+		socket->close();
+		socket->deleteLater();
+
+		return;
+	}
+
+	this->socket = socket;
+	this->input.clear();
+
+	QObject::connect(socket, SIGNAL(readyRead()), this, SLOT(readyReadSlot()));
+	QObject::connect(socket, SIGNAL(disconnected()), this, SLOT(disconnectedSlot()));
+
+	this->stop();
+}
+
+//! Process disconnecting of the debugger. All breakpoints are removed.
+void GDBServer::disconnectedSlot()
+{
+	this->cpu->clearBreakpoints();
+
+	if(!this->socket.isNull())
+	{
+		this->socket->deleteLater();
+		this->socket.clear();
+	}
+
+	this->running = false;
+}
+
+//! Process data received from the debugger
+void GDBServer::readyReadSlot()
+{
+	if(this->socket.isNull())
+	{
+		return;
+	}
+
+	this->input.append(this->socket->readAll());
+
+	while(!this->input.isEmpty() && (!this->socket.isNull()))
+	{
+		char c = this->input.at(0);
+
+		if(c == INTERRUPT)
+		{
+			this->input.remove(0, 1);
+
+			if(this->running)
+			{
+				this->stop();
+				this->sendStop(SIGNAL_INT);
+			}
+
+			continue;
+		}
+
+		if(c != '$')
+		{
+			// Acknowledgments and noise between packets
+			this->input.remove(0, 1);
+			continue;
+		}
+
+		int end = this->input.indexOf('#');
+
+		if((end < 0) || (this->input.size() < (end + 3)))
+		{
+			if(this->input.size() > (PACKET_SIZE * 2))
+			{
+				this->input.clear();
+			}
+
+			break;
+		}
+
+		QByteArray packet = this->input.mid(1, (end - 1));
+		bool checksumOk = false;
+		unsigned int checksum = this->input.mid((end + 1), 2).toUInt(&checksumOk, 16);
+
+		this->input.remove(0, (end + 3));
+
+		unsigned char sum = 0;
+
+		for(char p : packet)
+		{
+			sum = static_cast<unsigned char>(sum + static_cast<unsigned char>(p));
+		}
+
+		if((!checksumOk) || (checksum != sum))
+		{
+			this->socket->write("-");
+			continue;
+		}
+
+		this->socket->write("+");
+
+		this->processPacket(packet);
+	}
+}
+
+//! Process a breakpoint hit by the CPU
+void GDBServer::breakpointSlot()
+{
+	if(this->running)
+	{
+		this->running = false;
+
+		emit runningSignal(false);
+
+		this->sendStop(SIGNAL_TRAP);
+	}
+}
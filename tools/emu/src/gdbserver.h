@@ -0,0 +1,94 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef GDBSERVER_H
+#define GDBSERVER_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QPointer>
+
+#include "cpu.h"
+
+//! This class contains a server of the GDB Remote Serial Protocol used to debug the emulated CPU
+class GDBServer : public QObject
+{
+	Q_OBJECT
+
+	public:
+		static const int PACKET_SIZE = 4096; //!< Maximum size of a packet accepted by the server
+
+		static const char INTERRUPT = 0x03; //!< Byte sent by the debugger to stop the running target
+
+		static const int SIGNAL_INT = 2; //!< Signal reported after the interrupt from the debugger
+		static const int SIGNAL_TRAP = 5; //!< Signal reported after a breakpoint or a single step
+
+		GDBServer(CPU *cpu, QObject *parent = nullptr);
+		~GDBServer() override;
+
+		GDBServer(const GDBServer &) = delete;
+		GDBServer &operator=(const GDBServer &) = delete;
+		GDBServer(GDBServer &&) = delete;
+		GDBServer &operator=(GDBServer &&) = delete;
+
+		bool listen(quint16 port);
+
+	private:
+		//! Numbers of registers in the target description
+		enum Register
+		{
+			REG_A = 0, //!< A register
+			REG_B, //!< B register
+			REG_X, //!< X register
+			REG_Y, //!< Y register
+			REG_FLAGS, //!< C and Z flags of both sets, bits: C0, C1, Z0, Z1
+			REG_PC, //!< Program Counter
+			REG_SP, //!< Stack Pointer
+			REG_BP, //!< Base Pointer
+			REG_QUANTITY //!< Quantity of registers
+		};
+
+		CPU *cpu; //!< Debugged CPU
+		QTcpServer server; //!< Server waiting for the debugger
+		QPointer<QTcpSocket> socket; //!< Connection with the debugger
+
+		QByteArray input; //!< Received data waiting for processing
+		bool running; //!< Status of running the target after the continue command
+
+		void processPacket(const QByteArray &packet);
+		void sendPacket(const QByteArray &data);
+		void sendStop(int signal);
+
+		QByteArray readRegister(int number) const;
+		QByteArray readRegisters() const;
+		QByteArray readMemory(const QByteArray &args) const;
+		QByteArray writeMemory(const QByteArray &args);
+		QByteArray setBreakpoint(const QByteArray &args, bool enable);
+		QByteArray readFeatures(const QByteArray &args) const;
+
+		void resume();
+		void stop();
+
+	signals:
+		void runningSignal(bool running);
+
+	private slots:
+		void newConnectionSlot();
+		void disconnectedSlot();
+		void readyReadSlot();
+		void breakpointSlot();
+};
+
+#endif
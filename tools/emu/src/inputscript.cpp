@@ -0,0 +1,459 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "inputscript.h"
+
+/**
+ * Constructor for the input script class
+ *
+ * @param cpu CPU executing the steps
+ * @param io IO receiving the input
+ * @param parent Parent object
+ */
+InputScript::InputScript(CPU *cpu, IO *io, QObject *parent) : QObject(parent)
+{
+	this->cpu = cpu;
+	this->io = io;
+
+	this->generation = 0;
+
+	this->reset();
+
+	QObject::connect(this->io, SIGNAL(updateRS232TxSignal(QByteArray)), this, SLOT(transmitSlot(QByteArray)));
+}
+
+//! Destructor for the input script class
+InputScript::~InputScript()
+{
+	QObject::disconnect(this);
+}
+
+/**
+ * Load the script file. Every line is one statement, empty lines and lines starting with "#" are skipped:
+ * "type <text>", "key <name>", "delay <time>", "wait lcd <text>", "wait rs232 <text>", "timeout <time>", "send <text>" and "quit".
+ * Time is a quantity of CPU clock ticks or milliseconds with the "ms" suffix.
+ *
+ * @param path Path to the script file
+ * @param error Description of the first error
+ *
+ * @return Status of loading the script
+ */
+bool InputScript::load(const QString &path, QString &error)
+{
+	QFile file(path);
+
+	if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		error = "Unable to open the input script";
+		return(false);
+	}
+
+	QVector<Step> steps;
+	QTextStream stream(&file);
+	int line = 0;
+
+	while(!stream.atEnd())
+	{
+		const QString statement = stream.readLine().trimmed();
+
+		line++;
+
+		if(statement.isEmpty() || statement.startsWith('#'))
+		{
+			continue;
+		}
+
+		const int space = statement.indexOf(' ');
+		const QString command = ((space < 0) ? statement : statement.left(space)).toLower();
+		const QString argument = ((space < 0) ? QString() : statement.mid(space + 1));
+
+		Step step;
+
+		step.key = 0;
+		step.modifiers = Qt::NoModifier;
+		step.ticks = 0;
+		step.line = line;
+
+		bool valid = true;
+
+		if(command == "type")
+		{
+			step.type = StepType::Key;
+
+			for(const QChar &c : argument)
+			{
+				valid = (valid && parseChar(c, step.key, step.modifiers));
+
+				steps.append(step);
+			}
+
+			if(valid)
+			{
+				continue;
+			}
+		}
+		else if(command == "key")
+		{
+			step.type = StepType::Key;
+			valid = parseKey(argument, step.key, step.modifiers);
+		}
+		else if(command == "delay")
+		{
+			step.type = StepType::Delay;
+			valid = parseTicks(argument, step.ticks);
+		}
+		else if(command == "timeout")
+		{
+			step.type = StepType::Timeout;
+			valid = parseTicks(argument, step.ticks);
+		}
+		else if(command == "wait")
+		{
+			const int textSpace = argument.indexOf(' ');
+			const QString target = argument.left(textSpace).toLower();
+
+			step.type = ((target == "rs232") ? StepType::WaitRS232 : StepType::WaitLCD);
+			step.text = argument.mid(textSpace + 1).toLatin1();
+
+			valid = ((textSpace > 0) && ((target == "lcd") || (target == "rs232")));
+		}
+		else if(command == "send")
+		{
+			step.type = StepType::Send;
+			step.text = argument.toLatin1();
+		}
+		else if(command == "quit")
+		{
+			step.type = StepType::Quit;
+		}
+		else
+		{
+			valid = false;
+		}
+
+		if(!valid)
+		{
+			error = QString("Input script line %1: bad statement \"%2\"").arg(line).arg(statement);
+			return(false);
+		}
+
+		steps.append(step);
+	}
+
+	this->reset();
+	this->steps = steps;
+
+	return(true);
+}
+
+/**
+ * Start the script from the first step at the current tick of the CPU clock. It must be called between the emulation steps.
+ */
+void InputScript::start()
+{
+	this->reset();
+
+	this->started = true;
+	this->startTicks = this->cpu->getTicks();
+
+	this->schedule(this->startTicks);
+}
+
+//! Stop the script and move back to the first step. Events already added to the scheduler are ignored.
+void InputScript::reset()
+{
+	this->generation++;
+
+	this->position = 0;
+	this->started = false;
+
+	this->startTicks = 0;
+	this->waiting = false;
+	this->waitStartTicks = 0;
+	this->waitTimeout = 0;
+
+	this->rs232Tail.clear();
+}
+
+/**
+ * Get the running status of the script
+ *
+ * @return Status of running the script
+ */
+bool InputScript::isStarted() const
+{
+	return(this->started);
+}
+
+/**
+ * Parse a time value
+ *
+ * @param value Quantity of CPU clock ticks or milliseconds with the "ms" suffix
+ * @param ticks Parsed quantity of CPU clock ticks
+ *
+ * @return Status of parsing the value
+ */
+bool InputScript::parseTicks(const QString &value, unsigned long long &ticks)
+{
+	bool ok = false;
+
+	if(value.endsWith("ms"))
+	{
+		ticks = (value.left(value.size() - 2).toULongLong(&ok) * (CPU::FREQUENCY / 1000));
+	}
+	else
+	{
+		ticks = value.toULongLong(&ok);
+	}
+
+	return(ok);
+}
+
+/**
+ * Parse a name of a special key: ESC, TAB, ENTER, BACKSPACE, DELETE, UP, DOWN, LEFT, RIGHT or CTRL+<char>
+ *
+ * @param name Key name
+ * @param key Parsed key code for the keyboard
+ * @param modifiers Parsed key modifiers for the keyboard
+ *
+ * @return Status of parsing the name
+ */
+bool InputScript::parseKey(const QString &name, int &key, Qt::KeyboardModifiers &modifiers)
+{
+	const QString upperName = name.toUpper();
+
+	modifiers = Qt::NoModifier;
+
+	if(upperName.startsWith("CTRL+") && (upperName.size() == 6))
+	{
+		if(!parseChar(upperName.at(5), key, modifiers))
+		{
+			return(false);
+		}
+
+		// The control key gives the code of the small letter like on the window keyboard
+		modifiers = Qt::ControlModifier;
+
+		return(true);
+	}
+
+	if(upperName == "ESC")
+	{
+		key = Qt::Key_Escape;
+	}
+	else if(upperName == "TAB")
+	{
+		key = Qt::Key_Tab;
+	}
+	else if(upperName == "ENTER")
+	{
+		key = Qt::Key_Return;
+	}
+	else if(upperName == "BACKSPACE")
+	{
+		key = Qt::Key_Backspace;
+	}
+	else if(upperName == "DELETE")
+	{
+		key = Qt::Key_Delete;
+	}
+	else if(upperName == "UP")
+	{
+		key = Qt::Key_Up;
+	}
+	else if(upperName == "DOWN")
+	{
+		key = Qt::Key_Down;
+	}
+	else if(upperName == "LEFT")
+	{
+		key = Qt::Key_Left;
+	}
+	else if(upperName == "RIGHT")
+	{
+		key = Qt::Key_Right;
+	}
+	else
+	{
+		return(false);
+	}
+
+	return(true);
+}
+
+/**
+ * Convert a typed char to a key press of the keyboard
+ *
+ * @param c Typed char
+ * @param key Key code for the keyboard
+ * @param modifiers Key modifiers for the keyboard
+ *
+ * @return Status of converting the char, false when the keyboard has no such char
+ */
+bool InputScript::parseChar(QChar c, int &key, Qt::KeyboardModifiers &modifiers)
+{
+	const int code = c.unicode();
+
+	if((code < Keyboard::MIN_CODE) || (code > Keyboard::MAX_CODE))
+	{
+		return(false);
+	}
+
+	// Letters are given as capital keys, the shift key selects the capital letter
+	if((code >= 'a') && (code <= 'z'))
+	{
+		key = (code - ('a' - 'A'));
+		modifiers = Qt::NoModifier;
+	}
+	else
+	{
+		key = code;
+		modifiers = (((code >= 'A') && (code <= 'Z')) ? Qt::ShiftModifier : Qt::NoModifier);
+	}
+
+	return(true);
+}
+
+/**
+ * Add the execution of the next steps to the scheduler
+ *
+ * @param tick Tick of the CPU clock
+ */
+void InputScript::schedule(unsigned long long tick)
+{
+	const unsigned int generation = this->generation;
+
+	this->cpu->getScheduler().add(tick, [this, generation]() { this->execute(generation); });
+}
+
+/**
+ * Execute the steps until one of them waits. It is called by the scheduler.
+ *
+ * @param generation Counter of the script starts when the event was added
+ */
+void InputScript::execute(unsigned int generation)
+{
+	if((generation != this->generation) || (!this->started))
+	{
+		return;
+	}
+
+	while(this->position < this->steps.size())
+	{
+		const Step &step = this->steps.at(this->position);
+		const unsigned long long ticks = this->cpu->getTicks();
+
+		switch(step.type)
+		{
+			case StepType::Key :
+				this->io->keyboardKeyPress(step.key, step.modifiers);
+				break;
+
+			case StepType::Send :
+				this->io->rs232Receive(QString::fromLatin1(step.text));
+				break;
+
+			case StepType::Timeout :
+				this->waitTimeout = step.ticks;
+				break;
+
+			case StepType::Delay :
+				this->position++;
+				this->schedule(ticks + step.ticks);
+				return;
+
+			case StepType::WaitLCD :
+			case StepType::WaitRS232 :
+				if(!this->waiting)
+				{
+					this->waiting = true;
+					this->waitStartTicks = ticks;
+				}
+
+				if(!this->checkWait(step))
+				{
+					if((this->waitTimeout > 0) && ((ticks - this->waitStartTicks) >= this->waitTimeout))
+					{
+						this->started = false;
+
+						emit failedSignal(QString("Input script line %1: the text \"%2\" did not appear in time").arg(step.line).arg(QString::fromLatin1(step.text)));
+						return;
+					}
+
+					this->schedule(ticks + WAIT_POLL_TICKS);
+					return;
+				}
+
+				this->waiting = false;
+				break;
+
+			case StepType::Quit :
+				this->started = false;
+
+				emit quitSignal();
+				return;
+		}
+
+		this->position++;
+	}
+
+	this->started = false;
+
+	emit finishedSignal(this->cpu->getTicks() - this->startTicks);
+}
+
+/**
+ * Check the condition of a wait step. Transmitted RS232 text is used once, so the next wait looks only after the found text.
+ *
+ * @param step Wait step
+ *
+ * @return Status of meeting the condition
+ */
+bool InputScript::checkWait(const InputScript::Step &step)
+{
+	if(step.type == StepType::WaitLCD)
+	{
+		return(this->io->lcdContains(step.text));
+	}
+
+	const int index = this->rs232Tail.indexOf(step.text);
+
+	if(index < 0)
+	{
+		return(false);
+	}
+
+	this->rs232Tail.remove(0, (index + step.text.size()));
+
+	return(true);
+}
+
+/**
+ * Collect the transmitted RS232 chars for the waits. Zero ends a line, so it is kept as a line feed.
+ *
+ * @param data Transmitted chars
+ */
+void InputScript::transmitSlot(const QByteArray &data)
+{
+	if(!this->started)
+	{
+		return;
+	}
+
+	QByteArray text = data;
+
+	this->rs232Tail.append(text.replace('\0', '\n'));
+
+	if(this->rs232Tail.size() > RS232_TAIL_SIZE)
+	{
+		this->rs232Tail.remove(0, (this->rs232Tail.size() - RS232_TAIL_SIZE));
+	}
+}
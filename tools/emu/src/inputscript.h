@@ -0,0 +1,105 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef INPUTSCRIPT_H
+#define INPUTSCRIPT_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QFile>
+#include <QTextStream>
+
+#include "cpu.h"
+#include "io.h"
+
+//! This class contains a script of the keyboard and RS232 input. Steps are executed by the scheduler of the CPU, so they happen at exact ticks of the emulated time.
+class InputScript : public QObject
+{
+	Q_OBJECT
+
+	public:
+		static const unsigned long long WAIT_POLL_TICKS = (CPU::FREQUENCY / 1000); //!< CPU clock ticks between checks of a wait condition
+		static const int RS232_TAIL_SIZE = 4096; //!< Quantity of the last transmitted RS232 chars searched by a wait
+
+		InputScript(CPU *cpu, IO *io, QObject *parent = nullptr);
+		~InputScript() override;
+
+		InputScript(const InputScript &) = delete;
+		InputScript &operator=(const InputScript &) = delete;
+		InputScript(InputScript &&) = delete;
+		InputScript &operator=(InputScript &&) = delete;
+
+		bool load(const QString &path, QString &error);
+
+		void start();
+		void reset();
+
+		bool isStarted() const;
+
+	private:
+		//! Type of a script step
+		enum class StepType
+		{
+			Key, //!< Press a single key, typed text is a sequence of keys
+			Delay, //!< Wait the given quantity of ticks
+			WaitLCD, //!< Wait until the LCD shows the text
+			WaitRS232, //!< Wait until the RS232 transmits the text
+			Send, //!< Receive a line by the RS232
+			Timeout, //!< Set the time limit of the following waits
+			Quit //!< Quit the application
+		};
+
+		//! Single script step
+		struct Step
+		{
+			StepType type; //!< Type of the step
+			QByteArray text; //!< Text to send or wait for
+			int key; //!< Key code for the keyboard
+			Qt::KeyboardModifiers modifiers; //!< Key modifiers for the keyboard
+			unsigned long long ticks; //!< Delay or time limit in CPU clock ticks
+			int line; //!< Line of the script file
+		};
+
+		CPU *cpu; //!< CPU executing the steps
+		IO *io; //!< IO receiving the input
+
+		QVector<Step> steps; //!< Loaded steps
+		int position; //!< Index of the next step
+		bool started; //!< Status of running the script
+		unsigned int generation; //!< Counter of the script starts, events of a previous start are ignored
+
+		unsigned long long startTicks; //!< CPU clock ticks at the start of the script
+		bool waiting; //!< Status of waiting for a condition of the current step
+		unsigned long long waitStartTicks; //!< CPU clock ticks at the start of the current wait
+		unsigned long long waitTimeout; //!< Time limit of a wait in CPU clock ticks, 0 waits without a limit
+
+		QByteArray rs232Tail; //!< Last transmitted RS232 chars
+
+		static bool parseTicks(const QString &value, unsigned long long &ticks);
+		static bool parseKey(const QString &name, int &key, Qt::KeyboardModifiers &modifiers);
+		static bool parseChar(QChar c, int &key, Qt::KeyboardModifiers &modifiers);
+
+		void schedule(unsigned long long tick);
+		void execute(unsigned int generation);
+		bool checkWait(const InputScript::Step &step);
+
+	signals:
+		void finishedSignal(unsigned long long ticks);
+		void failedSignal(const QString &message);
+		void quitSignal();
+
+	private slots:
+		void transmitSlot(const QByteArray &data);
+};
+
+#endif
@@ -10,6 +10,7 @@
  */
 
 #include "io.h"
+#include "cpu.h"
 
 /**
  * Constructor for the IO class. It connects all communication classes for IO operations.
@@ -18,15 +19,19 @@
  */
 IO::IO(QObject *parent) : QObject(parent)
 {
+	this->rtc.setTicksPerSecond(CPU::FREQUENCY);
+
 	this->reset();
 
 	QObject::connect(&this->led, SIGNAL(updateRunSignal(bool)), this, SIGNAL(updateLEDRunSignal(bool)));
 	QObject::connect(&this->led, SIGNAL(updateErrorSignal(bool)), this, SIGNAL(updateLEDErrorSignal(bool)));
 
-	QObject::connect(&this->lcd, SIGNAL(updateBufferSignal(LCD::Buffer)), this, SIGNAL(updateLCDBufferSignal(LCD::Buffer)));
+	QObject::connect(&this->lcd, SIGNAL(updateCellsSignal(LCD::Cells)), this, SIGNAL(updateLCDCellsSignal(LCD::Cells)));
+	QObject::connect(&this->lcd, SIGNAL(updateFramesSignal(unsigned long long, unsigned long long)), this, SIGNAL(updateLCDFramesSignal(unsigned long long, unsigned long long)));
 
-	QObject::connect(&this->rs232, SIGNAL(updateTxSignal(unsigned char)), this, SIGNAL(updateRS232TxSignal(unsigned char)));
-	QObject::connect(&this->rs232, SIGNAL(updateRxSignal(unsigned char)), this, SIGNAL(updateRS232RxSignal(unsigned char)));
+	QObject::connect(&this->rs232, SIGNAL(updateTxSignal(QByteArray)), this, SIGNAL(updateRS232TxSignal(QByteArray)));
+	QObject::connect(&this->rs232, SIGNAL(updateRxSignal(QByteArray)), this, SIGNAL(updateRS232RxSignal(QByteArray)));
+	QObject::connect(&this->rs232, SIGNAL(receiveFreeSignal()), this, SIGNAL(rs232ReceiveFreeSignal()));
 
 	QObject::connect(&this->rtc, SIGNAL(updateDateTimeSignal(QDateTime)), this, SIGNAL(updateRTCDateTimeSignal(QDateTime)));
 
@@ -36,6 +41,177 @@ IO::IO(QObject *parent) : QObject(parent)
 	QObject::connect(&this->rs232, SIGNAL(dataReadySignal(bool)), this, SLOT(rs232DataReadySlot(bool)));
 }
 
+/**
+ * Get the processing time model of the real IO board. Values are estimated for the STM32F0 firmware running at 48 MHz
+ * and include the IRQ entry, decoding of the bus and the work done by the called function.
+ *
+ * @return Processing time model
+ */
+IO::Latency IO::boardLatency()
+{
+	Latency latency;
+
+	latency.regSelect = 3;
+	latency.read = 4;
+	latency.write = 4;
+
+	latency.regRead[RegAddress::REG_KEYBOARD] = 2;
+	latency.regRead[RegAddress::REG_RS232] = 2;
+	latency.regRead[RegAddress::REG_FS] = 12;
+
+	latency.regWrite[RegAddress::REG_LCD_CHAR] = 10;
+	latency.regWrite[RegAddress::REG_RS232] = 2;
+	latency.regWrite[RegAddress::REG_FS] = 2;
+	latency.regWrite[RegAddress::REG_LCD_STRING] = 2;
+
+	latency.commandLow[CommandLow::FS_OPEN_OS] = 1500;
+	latency.commandLow[CommandLow::FS_OPEN_APP] = 1500;
+	latency.commandLow[CommandLow::FS_OPEN_FILE] = 1500;
+	latency.commandLow[CommandLow::FS_LIST_APP] = 3000;
+	latency.commandLow[CommandLow::FS_LIST_FILE] = 3000;
+	latency.commandLow[CommandLow::FS_SEEK] = 300;
+	latency.commandLow[CommandLow::FS_OPEN_STREAM] = 1500;
+	latency.commandLow[CommandLow::FS_READ_BLOCK] = 600;
+
+	latency.fsBlockRead = 1;
+	latency.lcdStringChar = 2;
+
+	latency.commandHigh[CommandHigh::LCD_CLEAR] = 150;
+	latency.commandHigh[CommandHigh::LCD_REFRESH] = 300;
+	latency.commandHigh[CommandHigh::LCD_SCROLL_DOWN] = 250;
+	latency.commandHigh[CommandHigh::RTC_WRITE] = 200;
+	latency.commandHigh[CommandHigh::RTC_READ] = 100;
+	latency.commandHigh[CommandHigh::SPEAKER_PLAY] = 10;
+	latency.commandHigh[CommandHigh::SPEAKER_PAUSE] = 10;
+	latency.commandHigh[CommandHigh::SPEAKER_CLEAR] = 10;
+	latency.commandHigh[CommandHigh::SPEAKER_ADD_NOTE] = 10;
+
+	return(latency);
+}
+
+/**
+ * Override values of the processing time model with a table from the file. One "key = ticks" pair per line, empty lines and lines starting with "#" are skipped.
+ * Keys are "reg_select", "read", "write", "fs_block_read", "lcd_string_char", "read.REGISTER", "write.REGISTER" and "command.COMMAND",
+ * where names of registers and commands are the names of the enums without the "REG_" prefix in lower case, e.g. "read.fs" or "command.fs_open_file".
+ *
+ * @param path Path to the table file
+ * @param latency Processing time model to change
+ * @param error Error message
+ *
+ * @return Status of loading the table
+ */
+bool IO::loadLatency(const QString &path, IO::Latency &latency, QString &error)
+{
+	const QMap<QString, int> regNames = {
+		{ "command", RegAddress::REG_COMMAND }, { "status", RegAddress::REG_STATUS }, { "field_address", RegAddress::REG_FIELD_ADDRESS },
+		{ "field", RegAddress::REG_FIELD }, { "keyboard", RegAddress::REG_KEYBOARD }, { "lcd_color", RegAddress::REG_LCD_COLOR },
+		{ "lcd_cursor_pos_x", RegAddress::REG_LCD_CURSOR_POS_X }, { "lcd_cursor_pos_y", RegAddress::REG_LCD_CURSOR_POS_Y }, { "lcd_char", RegAddress::REG_LCD_CHAR },
+		{ "rs232", RegAddress::REG_RS232 }, { "fs", RegAddress::REG_FS }, { "lcd_string", RegAddress::REG_LCD_STRING }
+	};
+
+	const QMap<QString, int> commandLowNames = {
+		{ "fs_open_os", CommandLow::FS_OPEN_OS }, { "fs_reset_name", CommandLow::FS_RESET_NAME }, { "fs_open_app", CommandLow::FS_OPEN_APP },
+		{ "fs_open_file", CommandLow::FS_OPEN_FILE }, { "fs_list_app", CommandLow::FS_LIST_APP }, { "fs_list_file", CommandLow::FS_LIST_FILE },
+		{ "perf_latch", CommandLow::PERF_LATCH }, { "fs_seek", CommandLow::FS_SEEK }, { "fs_open_stream", CommandLow::FS_OPEN_STREAM },
+		{ "fs_read_block", CommandLow::FS_READ_BLOCK }
+	};
+
+	const QMap<QString, int> commandHighNames = {
+		{ "led_run_off", CommandHigh::LED_RUN_OFF }, { "led_run_on", CommandHigh::LED_RUN_ON }, { "led_error_off", CommandHigh::LED_ERROR_OFF },
+		{ "led_error_on", CommandHigh::LED_ERROR_ON }, { "lcd_clear", CommandHigh::LCD_CLEAR }, { "lcd_refresh", CommandHigh::LCD_REFRESH },
+		{ "lcd_scroll_down", CommandHigh::LCD_SCROLL_DOWN }, { "lcd_new_line", CommandHigh::LCD_NEW_LINE }, { "rtc_write", CommandHigh::RTC_WRITE },
+		{ "rtc_read", CommandHigh::RTC_READ }, { "speaker_play", CommandHigh::SPEAKER_PLAY }, { "speaker_pause", CommandHigh::SPEAKER_PAUSE },
+		{ "speaker_clear", CommandHigh::SPEAKER_CLEAR }, { "speaker_add_note", CommandHigh::SPEAKER_ADD_NOTE }, { "speaker_get_buffer_free", CommandHigh::SPEAKER_GET_BUFFER_FREE }
+	};
+
+	QFile file(path);
+
+	if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		error = "Unable to open the IO latency table";
+		return(false);
+	}
+
+	QTextStream stream(&file);
+	int lineNumber = 0;
+
+	while(!stream.atEnd())
+	{
+		const QString line = stream.readLine().trimmed();
+
+		lineNumber++;
+
+		if(line.isEmpty() || line.startsWith('#'))
+		{
+			continue;
+		}
+
+		const int separator = line.indexOf('=');
+		bool ok = false;
+		unsigned int ticks = 0;
+
+		if(separator > 0)
+		{
+			ticks = line.mid(separator + 1).trimmed().toUInt(&ok);
+		}
+
+		if(!ok)
+		{
+			error = QString("Bad line %1 of the IO latency table").arg(lineNumber);
+			return(false);
+		}
+
+		const QString key = line.left(separator).trimmed().toLower();
+		const QString name = key.section('.', 1);
+
+		if(key == "reg_select")
+		{
+			latency.regSelect = ticks;
+		}
+		else if(key == "read")
+		{
+			latency.read = ticks;
+		}
+		else if(key == "write")
+		{
+			latency.write = ticks;
+		}
+		else if(key == "fs_block_read")
+		{
+			latency.fsBlockRead = ticks;
+		}
+		else if(key == "lcd_string_char")
+		{
+			latency.lcdStringChar = ticks;
+		}
+		else if(key.startsWith("read.") && regNames.contains(name))
+		{
+			latency.regRead[regNames.value(name)] = ticks;
+		}
+		else if(key.startsWith("write.") && regNames.contains(name))
+		{
+			latency.regWrite[regNames.value(name)] = ticks;
+		}
+		else if(key.startsWith("command.") && commandLowNames.contains(name))
+		{
+			latency.commandLow[commandLowNames.value(name)] = ticks;
+		}
+		else if(key.startsWith("command.") && commandHighNames.contains(name))
+		{
+			latency.commandHigh[commandHighNames.value(name)] = ticks;
+		}
+		else
+		{
+			error = QString("Unknown key \"%1\" at line %2 of the IO latency table").arg(key).arg(lineNumber);
+			return(false);
+		}
+	}
+
+	file.close();
+
+	return(true);
+}
+
 //! Destructor for the IO class
 IO::~IO()
 {
@@ -49,6 +225,19 @@ void IO::reset()
 	this->reg = {};
 	this->in = 0;
 
+	this->ticks = 0;
+	this->instructions = 0;
+
+	this->osLoaded = false;
+	this->operations = 0;
+	this->fsBlockRead = false;
+	this->fsPrefetched = false;
+	this->fsPrefetchReady = 0;
+	this->lcdStringPrinted = 0;
+	this->lcdStringRefreshed = false;
+
+	this->resetTransfer();
+
 	this->keyboard.reset();
 	this->led.reset();
 	this->lcd.reset();
@@ -58,6 +247,155 @@ void IO::reset()
 	this->fs.reset();
 }
 
+//! Reset the halves of bytes collected by the transfers, so the next transfer starts from a new byte. It is used when code is replaced without a reset of the machine.
+void IO::resetTransfer()
+{
+	this->readLatch.fill(0);
+	this->writeLatch.fill(0);
+}
+
+/**
+ * Set the scheduler of the CPU. It is used to report completed operations after the processing time of the IO board and to play speaker notes in the emulated time.
+ *
+ * @param scheduler Scheduler of the CPU
+ */
+void IO::setScheduler(Scheduler *scheduler)
+{
+	this->scheduler = scheduler;
+
+	this->speaker.setScheduler(scheduler, (CPU::FREQUENCY / 1000));
+}
+
+/**
+ * Set the processing time model of the IO board. Default model completes every operation instantly.
+ *
+ * @param latency Processing time model
+ */
+void IO::setLatency(const IO::Latency &latency)
+{
+	this->latency = latency;
+}
+
+/**
+ * Get the processing time model of the IO board
+ *
+ * @return Processing time model
+ */
+const IO::Latency &IO::getLatency() const
+{
+	return(this->latency);
+}
+
+/**
+ * Save the virtual registers and the state of all connected communication classes to the state stream.
+ * The speaker is not saved, it must be idle when the state is saved.
+ *
+ * @param stream State stream
+ */
+void IO::saveState(QDataStream &stream) const
+{
+	stream << this->regSelected << static_cast<unsigned char>(this->in) << this->ticks << this->instructions;
+	stream << this->osLoaded << this->operations << this->fsPrefetched << this->fsPrefetchReady;
+
+	stream << this->reg.statusAddress << this->reg.fieldAddress;
+	stream << this->reg.rtc.year << this->reg.rtc.month << this->reg.rtc.day << this->reg.rtc.hour << this->reg.rtc.minute << this->reg.rtc.second;
+	stream << this->reg.speaker.note.note << this->reg.speaker.note.time << this->reg.speaker.note.fill << this->reg.speaker.note.volume << this->reg.speaker.bufferFree;
+	stream << this->reg.fs.name << this->reg.fs.size.low << this->reg.fs.size.high << this->reg.fs.size.ext << this->reg.fs.status;
+
+	for(unsigned char offset : this->reg.fs.offset)
+	{
+		stream << offset;
+	}
+
+	for(unsigned char counter : this->reg.perf.counter)
+	{
+		stream << counter;
+	}
+
+	stream << this->reg.perf.position << this->reg.perf.value;
+	stream << this->reg.lcd.string;
+
+	this->keyboard.saveState(stream);
+	this->led.saveState(stream);
+	this->lcd.saveState(stream);
+	this->rs232.saveState(stream);
+	this->rtc.saveState(stream);
+	this->fs.saveState(stream);
+}
+
+/**
+ * Load the virtual registers and the state of all connected communication classes from the state stream
+ *
+ * @param stream State stream
+ *
+ * @return Status of loading the state
+ */
+bool IO::loadState(QDataStream &stream)
+{
+	this->reset();
+
+	unsigned char in = 0;
+
+	stream >> this->regSelected >> in >> this->ticks >> this->instructions;
+	stream >> this->osLoaded >> this->operations >> this->fsPrefetched >> this->fsPrefetchReady;
+
+	this->in = in;
+
+	stream >> this->reg.statusAddress >> this->reg.fieldAddress;
+	stream >> this->reg.rtc.year >> this->reg.rtc.month >> this->reg.rtc.day >> this->reg.rtc.hour >> this->reg.rtc.minute >> this->reg.rtc.second;
+	stream >> this->reg.speaker.note.note >> this->reg.speaker.note.time >> this->reg.speaker.note.fill >> this->reg.speaker.note.volume >> this->reg.speaker.bufferFree;
+	stream >> this->reg.fs.name >> this->reg.fs.size.low >> this->reg.fs.size.high >> this->reg.fs.size.ext >> this->reg.fs.status;
+
+	for(unsigned char &offset : this->reg.fs.offset)
+	{
+		stream >> offset;
+	}
+
+	for(unsigned char &counter : this->reg.perf.counter)
+	{
+		stream >> counter;
+	}
+
+	stream >> this->reg.perf.position >> this->reg.perf.value;
+	stream >> this->reg.lcd.string;
+
+	this->keyboard.loadState(stream);
+	this->led.loadState(stream);
+	this->lcd.loadState(stream);
+	this->rs232.loadState(stream);
+	this->rtc.loadState(stream);
+	this->fs.loadState(stream);
+
+	if(stream.status() != QDataStream::Ok)
+	{
+		this->reset();
+
+		return(false);
+	}
+
+	return(true);
+}
+
+/**
+ * Get status of opening the OS file by the BIOS
+ *
+ * @return Status of opening the OS file
+ */
+bool IO::isOSLoaded() const
+{
+	return(this->osLoaded);
+}
+
+/**
+ * Get counter of processed IO operations
+ *
+ * @return Counter of processed IO operations
+ */
+unsigned long long IO::getOperations() const
+{
+	return(this->operations);
+}
+
 /**
  * Process a key press event
  *
@@ -89,6 +427,28 @@ void IO::ledSetError(bool enable)
 	this->led.setError(enable);
 }
 
+/**
+ * Set the maximum quantity of presented LCD frames per second
+ *
+ * @param fps Frames per second, 0 presents every refresh immediately
+ */
+void IO::lcdSetFPS(int fps)
+{
+	this->lcd.setFPS(fps);
+}
+
+/**
+ * Check if the refreshed LCD screen shows the text in one row
+ *
+ * @param text Text to find
+ *
+ * @return Status of finding the text
+ */
+bool IO::lcdContains(const QByteArray &text) const
+{
+	return(this->lcd.contains(text));
+}
+
 /**
  * Process a received text event
  *
@@ -99,14 +459,58 @@ void IO::rs232Receive(const QString &text)
 	this->rs232.rx(text);
 }
 
+/**
+ * Process received bytes from the bridge
+ *
+ * @param data Received bytes
+ *
+ * @return Quantity of used bytes, the rest must be given again after the receive free signal
+ */
+int IO::rs232ReceiveRaw(const QByteArray &data)
+{
+	return(this->rs232.rxRaw(data));
+}
+
+/**
+ * Get free space size in the receive ring of the RS232
+ *
+ * @return Free space size in bytes
+ */
+int IO::rs232GetReceiveFree() const
+{
+	return(this->rs232.getReceiveRingFree());
+}
+
 /**
  * Set date and time
  *
- * @param dateTime Date and time to set in own RTC format
+ * @param dateTime Date and time to set in Qt format
  */
 void IO::rtcSetDateTime(const QDateTime &dateTime)
 {
-	this->rtc.setDateTime(dateTime);
+	this->rtc.setDateTime(dateTime, this->ticks);
+}
+
+/**
+ * Get current date and time of the RTC
+ *
+ * @return Date and time in Qt format
+ */
+QDateTime IO::rtcGetDateTime() const
+{
+	return(this->rtc.getCurrent(this->ticks));
+}
+
+/**
+ * Set the source of the RTC time
+ *
+ * @param mode Source of the time
+ * @param epoch Date and time of the emulated mode after a reset
+ */
+void IO::rtcSetMode(RTC::Mode mode, const QDateTime &epoch)
+{
+	this->rtc.setMode(mode);
+	this->rtc.setEpoch(epoch);
 }
 
 /**
@@ -119,6 +523,54 @@ void IO::speakerSetVolume(unsigned int volume)
 	this->speaker.setVolume(volume);
 }
 
+/**
+ * Set smoothing of the square wave edges of the speaker
+ *
+ * @param enable Enable status
+ */
+void IO::speakerSetBandLimited(bool enable)
+{
+	this->speaker.setBandLimited(enable);
+}
+
+/**
+ * Set playing speaker samples on the audio device
+ *
+ * @param enable Enable status
+ */
+void IO::speakerSetDeviceEnabled(bool enable)
+{
+	this->speaker.setDeviceEnabled(enable);
+}
+
+/**
+ * Set the WAV file for the samples played by the speaker
+ *
+ * @param path Path to the WAV file
+ *
+ * @return Status of creating the file
+ */
+bool IO::speakerSetWavPath(const QString &path)
+{
+	return(this->speaker.setWavPath(path));
+}
+
+//! Stop playing sound and clear the sound buffer
+void IO::speakerClear()
+{
+	this->speaker.clear();
+}
+
+/**
+ * Get status of playing sound
+ *
+ * @return Status of playing sound
+ */
+bool IO::speakerIsPlaying()
+{
+	return(this->speaker.isPlaying());
+}
+
 /**
  * Set path to the emulated file system on the local disk
  *
@@ -224,9 +676,11 @@ unsigned char IO::outReadStatus(bool half)
 /**
  * Read a value of the selected field register
  *
+ * @param half Half of register selector
+ *
  * @return Read data
  */
-unsigned char IO::outReadField()
+unsigned char IO::outReadField(bool half)
 {
 	unsigned char data = 0;
 
@@ -240,6 +694,20 @@ unsigned char IO::outReadField()
 			data = this->reg.fs.size.high;
 			break;
 
+		case FieldR::FS_DATA_SIZE_EXT :
+			data = this->reg.fs.size.ext;
+			break;
+
+		case FieldR::PERF_COUNTER :
+			if(half == HALF_LOW)
+			{
+				this->reg.perf.value = this->reg.perf.counter[this->reg.perf.position];
+				this->reg.perf.position = ((this->reg.perf.position + 1) % (PERF_COUNTER_SIZE * 2));
+			}
+
+			data = this->reg.perf.value;
+			break;
+
 		case FieldR::SPEAKER_BUFFER_FREE :
 			data = this->reg.speaker.bufferFree;
 			break;
@@ -281,7 +749,7 @@ unsigned char IO::outReadField()
  */
 unsigned char IO::outReadKeyboard(bool half)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->readLatch[RegAddress::REG_KEYBOARD];
 
 	if(half == HALF_LOW)
 	{
@@ -300,7 +768,7 @@ unsigned char IO::outReadKeyboard(bool half)
  */
 unsigned char IO::outReadLCDCursorPosX(bool half)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->readLatch[RegAddress::REG_LCD_CURSOR_POS_X];
 
 	if(half == HALF_LOW)
 	{
@@ -319,7 +787,7 @@ unsigned char IO::outReadLCDCursorPosX(bool half)
  */
 unsigned char IO::outReadLCDCursorPosY(bool half)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->readLatch[RegAddress::REG_LCD_CURSOR_POS_Y];
 
 	if(half == HALF_LOW)
 	{
@@ -338,7 +806,7 @@ unsigned char IO::outReadLCDCursorPosY(bool half)
  */
 unsigned char IO::outReadRS232Rx(bool half)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->readLatch[RegAddress::REG_RS232];
 
 	if(half == HALF_LOW)
 	{
@@ -357,10 +825,12 @@ unsigned char IO::outReadRS232Rx(bool half)
  */
 unsigned char IO::outReadFSData(bool half)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->readLatch[RegAddress::REG_FS];
 
 	if(half == HALF_LOW)
 	{
+		this->fsBlockRead = this->fs.isInBlock();
+
 		data = this->fs.readNextDataByte();
 	}
 
@@ -380,7 +850,8 @@ void IO::outWriteCommand(bool half, unsigned char dataInRaw)
 		switch(dataInRaw)
 		{
 			case CommandLow::FS_OPEN_OS :
-				this->reg.fs.status = this->fs.open("os.bin", this->reg.fs.size);
+				this->reg.fs.status = this->fs.open("os.bin", this->reg.fs.size, FS::FILE_MAX_SIZE);
+				this->osLoaded = this->reg.fs.status;
 				break;
 
 			case CommandLow::FS_RESET_NAME :
@@ -388,11 +859,23 @@ void IO::outWriteCommand(bool half, unsigned char dataInRaw)
 				break;
 
 			case CommandLow::FS_OPEN_APP :
-				this->reg.fs.status = this->fs.open(QString("app/").append(this->reg.fs.name), this->reg.fs.size);
+				this->reg.fs.status = this->fs.open(QString("app/").append(this->reg.fs.name), this->reg.fs.size, FS::FILE_MAX_SIZE);
 				break;
 
 			case CommandLow::FS_OPEN_FILE :
-				this->reg.fs.status = this->fs.open(QString("file/").append(this->reg.fs.name), this->reg.fs.size);
+				this->reg.fs.status = this->fs.open(QString("file/").append(this->reg.fs.name), this->reg.fs.size, FS::FILE_MAX_SIZE);
+				break;
+
+			case CommandLow::FS_SEEK :
+				this->reg.fs.status = this->fs.seek(this->reg.fs.offset[0] | (this->reg.fs.offset[1] << 8) | (this->reg.fs.offset[2] << 16));
+				break;
+
+			case CommandLow::FS_OPEN_STREAM :
+				this->reg.fs.status = this->fs.open(QString("file/").append(this->reg.fs.name), this->reg.fs.size, FS::STREAM_MAX_SIZE);
+				break;
+
+			case CommandLow::FS_READ_BLOCK :
+				this->reg.fs.status = this->fs.readBlock();
 				break;
 
 			case CommandLow::FS_LIST_APP :
@@ -402,6 +885,16 @@ void IO::outWriteCommand(bool half, unsigned char dataInRaw)
 			case CommandLow::FS_LIST_FILE :
 				this->reg.fs.status = this->fs.list("file", this->reg.fs.size);
 				break;
+
+			case CommandLow::PERF_LATCH :
+				for(int i = 0; i < PERF_COUNTER_SIZE; i++)
+				{
+					this->reg.perf.counter[i] = static_cast<unsigned char>((this->ticks >> (i * 8)) & 0xff);
+					this->reg.perf.counter[PERF_COUNTER_SIZE + i] = static_cast<unsigned char>((this->instructions >> (i * 8)) & 0xff);
+				}
+
+				this->reg.perf.position = 0;
+				break;
 		}
 	}
 	else
@@ -444,22 +937,24 @@ void IO::outWriteCommand(bool half, unsigned char dataInRaw)
 				break;
 
 			case CommandHigh::RTC_WRITE :
-				this->rtc.setDateTime(this->reg.rtc);
+				this->rtc.setDateTime(this->reg.rtc, this->ticks);
 				break;
 
 			case CommandHigh::RTC_READ :
-				this->reg.rtc = this->rtc.getDateTime();
+				this->reg.rtc = this->rtc.getDateTime(this->ticks);
 				break;
 
 			case CommandHigh::SPEAKER_PLAY :
-				this->speaker.play();
+				this->speaker.play(this->ticks);
 				break;
 
 			case CommandHigh::SPEAKER_PAUSE :
-				this->speaker.pause();
+				this->speaker.pause(this->ticks);
 				break;
 
 			case CommandHigh::SPEAKER_CLEAR :
+				// Cut the current note at the emulated time before dropping the queue
+				this->speaker.pause(this->ticks);
 				this->speaker.clear();
 				break;
 
@@ -503,7 +998,7 @@ void IO::outWriteFieldAddress(unsigned char dataInRaw)
  */
 void IO::outWriteField(bool half, unsigned char dataIn, unsigned char mask)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->writeLatch[RegAddress::REG_FIELD];
 
 	data = ((data & mask) | dataIn);
 
@@ -511,6 +1006,18 @@ void IO::outWriteField(bool half, unsigned char dataIn, unsigned char mask)
 	{
 		switch(this->reg.fieldAddress)
 		{
+			case FieldW::FS_OFFSET_LOW :
+				this->reg.fs.offset[0] = data;
+				break;
+
+			case FieldW::FS_OFFSET_MIDDLE :
+				this->reg.fs.offset[1] = data;
+				break;
+
+			case FieldW::FS_OFFSET_HIGH :
+				this->reg.fs.offset[2] = data;
+				break;
+
 			case FieldRW::RTC_YEAR :
 				this->reg.rtc.year = data;
 				break;
@@ -581,7 +1088,7 @@ void IO::outWriteLCDColor(bool half, unsigned char dataInRaw)
  */
 void IO::outWriteLCDCursorPosX(bool half, unsigned char dataIn, unsigned char mask)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->writeLatch[RegAddress::REG_LCD_CURSOR_POS_X];
 
 	data = ((data & mask) | dataIn);
 
@@ -600,7 +1107,7 @@ void IO::outWriteLCDCursorPosX(bool half, unsigned char dataIn, unsigned char ma
  */
 void IO::outWriteLCDCursorPosY(bool half, unsigned char dataIn, unsigned char mask)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->writeLatch[RegAddress::REG_LCD_CURSOR_POS_Y];
 
 	data = ((data & mask) | dataIn);
 
@@ -619,7 +1126,7 @@ void IO::outWriteLCDCursorPosY(bool half, unsigned char dataIn, unsigned char ma
  */
 void IO::outWriteLCDChar(bool half, unsigned char dataIn, unsigned char mask)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->writeLatch[RegAddress::REG_LCD_CHAR];
 
 	data = ((data & mask) | dataIn);
 
@@ -638,7 +1145,7 @@ void IO::outWriteLCDChar(bool half, unsigned char dataIn, unsigned char mask)
  */
 void IO::outWriteCRS232Tx(bool half, unsigned char dataIn, unsigned char mask)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->writeLatch[RegAddress::REG_RS232];
 
 	data = ((data & mask) | dataIn);
 
@@ -657,7 +1164,7 @@ void IO::outWriteCRS232Tx(bool half, unsigned char dataIn, unsigned char mask)
  */
 void IO::outWriteFSName(bool half, unsigned char dataIn, unsigned char mask)
 {
-	static unsigned char data = 0;
+	unsigned char &data = this->writeLatch[RegAddress::REG_FS];
 
 	data = ((data & mask) | dataIn);
 
@@ -673,6 +1180,140 @@ void IO::outWriteFSName(bool half, unsigned char dataIn, unsigned char mask)
 	}
 }
 
+/**
+ * Add a char to the LCD string buffer. Zero prints the buffered string and refreshes the LCD once.
+ * A full buffer is printed without the refresh, so strings longer than the buffer are not cut.
+ *
+ * @param half Half of register selector
+ * @param dataIn Data to write
+ * @param mask Mask of input data
+ */
+void IO::outWriteLCDString(bool half, unsigned char dataIn, unsigned char mask)
+{
+	unsigned char &data = this->writeLatch[RegAddress::REG_LCD_STRING];
+
+	data = ((data & mask) | dataIn);
+
+	if(half == HALF_HIGH)
+	{
+		if(data == 0x00)
+		{
+			this->lcdFlushString();
+
+			this->lcd.refresh();
+			this->lcd.update();
+			this->lcdStringRefreshed = true;
+		}
+		else
+		{
+			if(this->reg.lcd.string.size() >= LCD_STRING_MAX_LENGTH)
+			{
+				this->lcdFlushString();
+			}
+
+			this->reg.lcd.string.append(static_cast<char>(data));
+		}
+	}
+}
+
+//! Print chars from the LCD string buffer without the refresh
+void IO::lcdFlushString()
+{
+	if(this->reg.lcd.string.isEmpty())
+	{
+		return;
+	}
+
+	this->lcd.printString(this->reg.lcd.string);
+	this->lcdStringPrinted += this->reg.lcd.string.size();
+	this->reg.lcd.string.clear();
+}
+
+/**
+ * Get the processing time of the operation by the IO board
+ *
+ * @param half Half of register selector
+ * @param mode Register select or data transfer mode
+ * @param rw Read or write mode
+ * @param dataInRaw Not shifted data half from the output register
+ *
+ * @return Processing time in CPU clock ticks
+ */
+unsigned int IO::getOperationLatency(bool half, bool mode, bool rw, unsigned char dataInRaw) const
+{
+	if(mode == MODE_REG_SELECT)
+	{
+		return(this->latency.regSelect);
+	}
+
+	// Chars of the LCD string buffer printed by this operation
+	unsigned int latency = (static_cast<unsigned int>(this->lcdStringPrinted) * this->latency.lcdStringChar);
+
+	if(this->lcdStringRefreshed)
+	{
+		latency += this->latency.commandHigh[CommandHigh::LCD_REFRESH];
+	}
+
+	if(rw == RW_READ)
+	{
+		latency += this->latency.read;
+
+		if(half == HALF_HIGH)
+		{
+			return(latency);
+		}
+
+		if(this->regSelected == RegAddress::REG_FS)
+		{
+			unsigned int fetch = (this->fsBlockRead ? this->latency.fsBlockRead : this->latency.regRead[this->regSelected]);
+
+			// The byte is fetched while the CPU was busy after the previous one, only the rest of the fetch time is waited
+			if(this->fsPrefetched)
+			{
+				fetch = ((this->fsPrefetchReady > this->ticks) ? static_cast<unsigned int>(qMin(static_cast<unsigned long long>(fetch), (this->fsPrefetchReady - this->ticks))) : 0);
+			}
+
+			return(latency + fetch);
+		}
+
+		return(latency + this->latency.regRead[this->regSelected]);
+	}
+
+	latency += this->latency.write;
+
+	if(half == HALF_HIGH)
+	{
+		latency += this->latency.regWrite[this->regSelected];
+	}
+
+	if(this->regSelected == RegAddress::REG_COMMAND)
+	{
+		latency += ((half == HALF_LOW) ? this->latency.commandLow[dataInRaw] : this->latency.commandHigh[dataInRaw]);
+	}
+
+	return(latency);
+}
+
+//! Toggle the operation completed bit and send the input register to the CPU
+void IO::completeOperation()
+{
+	this->in ^= IN_OPERATION_COMPLETE_BIT;
+
+	emit inSignal(this->in);
+}
+
+/**
+ * Process "update the CPU counters" event. It is emitted by the CPU just before every IO operation.
+ *
+ * @param ticks Clock ticks of the CPU
+ * @param instructions Executed instructions of the CPU
+ */
+void IO::counterSlot(unsigned long long ticks, unsigned long long instructions)
+{
+	this->ticks = ticks;
+	this->instructions = instructions;
+}
+
 /**
  * Process "update the output register value" event.
  * Fill up the output register data half with corresponding data from selected virtual register.
@@ -689,6 +1330,15 @@ void IO::outSlot(unsigned char out)
 		bool mode = ((value & OUT_MODE_BIT) ? MODE_DATA_TRANSFER : MODE_REG_SELECT);
 		bool rw = ((value & OUT_RW_BIT) ? RW_WRITE : RW_READ);
 
+		this->lcdStringPrinted = 0;
+		this->lcdStringRefreshed = false;
+
+		// Chars buffered by the LCD string register are printed before any other LCD operation, so the order of the output is kept
+		if((mode == MODE_DATA_TRANSFER) && (((this->regSelected >= RegAddress::REG_LCD_COLOR) && (this->regSelected <= RegAddress::REG_LCD_CHAR)) || ((this->regSelected == RegAddress::REG_COMMAND) && (rw == RW_WRITE) && (half == HALF_HIGH))))
+		{
+			this->lcdFlushString();
+		}
+
 		if(mode == MODE_REG_SELECT)
 		{
 			// Select register to work
@@ -707,7 +1357,7 @@ void IO::outSlot(unsigned char out)
 						break;
 
 					case RegAddress::REG_FIELD :
-						dataOut = this->outReadField();
+						dataOut = this->outReadField(half);
 						break;
 
 					case RegAddress::REG_KEYBOARD :
@@ -792,13 +1442,34 @@ void IO::outSlot(unsigned char out)
 					case RegAddress::REG_FS :
 						this->outWriteFSName(half, dataIn, mask);
 						break;
+
+					case RegAddress::REG_LCD_STRING :
+						this->outWriteLCDString(half, dataIn, mask);
+						break;
 				}
 			}
 		}
 
-		// Operation is completed
-		this->in ^= IN_OPERATION_COMPLETE_BIT;
+		this->operations++;
+
+		unsigned int latency = this->getOperationLatency(half, mode, rw, (value & IN_DATA_MASK));
 
-		emit inSignal(this->in);
+		// In the streaming mode the register stays selected, so the IO board fetches the next FS byte just after the previous one is read
+		this->fsPrefetched = ((mode == MODE_DATA_TRANSFER) && (rw == RW_READ) && (half == HALF_HIGH) && (this->regSelected == RegAddress::REG_FS));
+
+		if(this->fsPrefetched)
+		{
+			this->fsPrefetchReady = (this->ticks + latency + (this->fs.isInBlock() ? this->latency.fsBlockRead : this->latency.regRead[RegAddress::REG_FS]));
+		}
+
+		// Operation is completed
+		if((latency == 0) || (this->scheduler == nullptr))
+		{
+			this->completeOperation();
+		}
+		else
+		{
+			this->scheduler->add((this->ticks + latency), [this]() { this->completeOperation(); });
+		}
 	}
 }
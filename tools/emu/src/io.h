@@ -18,6 +18,12 @@
 #include <QDateTime>
 #include <QThread>
 #include <QCoreApplication>
+#include <QDataStream>
+#include <QByteArray>
+#include <QString>
+#include <QMap>
+#include <QFile>
+#include <QTextStream>
 
 #include "keyboard.h"
 #include "led.h"
@@ -26,6 +32,7 @@
 #include "rtc.h"
 #include "speaker.h"
 #include "fs.h"
+#include "scheduler.h"
 
 //! This class contains IO functions. It is a motherboard simulation part for the CPU.
 class IO : public QObject
@@ -54,6 +61,30 @@ class IO : public QObject
 		static const unsigned char HALF_UP_DATA_MASK = 0xf0; //!< Upper half of the byte mask
 		static const int HALF_DATA_OFFSET = 4; //!< Upper half of the byte offset
 
+		static const int PERF_COUNTER_SIZE = 4; //!< Size in bytes of a single latched performance counter
+		static const int FS_OFFSET_SIZE = 3; //!< Size in bytes of the seek offset
+		static const int LCD_STRING_MAX_LENGTH = LCD::WIDTH; //!< Maximum length of a string buffered before it is printed
+
+		static const int REG_QUANTITY = 16; //!< Quantity of addressable registers
+		static const int COMMAND_QUANTITY = 16; //!< Quantity of commands in a single part of the command register
+
+		//! Processing time model of the IO board. Every value is a count of CPU clock ticks after which the operation is reported as completed.
+		struct Latency
+		{
+			unsigned int regSelect = 0; //!< Cost of a register selection
+			unsigned int read = 0; //!< Base cost of a half read
+			unsigned int write = 0; //!< Base cost of a half write
+			QVector<unsigned int> regRead = QVector<unsigned int>(REG_QUANTITY, 0); //!< Additional cost of a byte read for every register. It is added to the low half which fetches the byte.
+			QVector<unsigned int> regWrite = QVector<unsigned int>(REG_QUANTITY, 0); //!< Additional cost of a byte write for every register. It is added to the high half which completes the byte.
+			QVector<unsigned int> commandLow = QVector<unsigned int>(COMMAND_QUANTITY, 0); //!< Additional cost of every low part command
+			QVector<unsigned int> commandHigh = QVector<unsigned int>(COMMAND_QUANTITY, 0); //!< Additional cost of every high part command
+			unsigned int fsBlockRead = 0; //!< Additional cost of a byte read from the FS block read ahead. It is used instead of the FS register cost.
+			unsigned int lcdStringChar = 0; //!< Additional cost of every char printed from the LCD string buffer
+		};
+
+		static IO::Latency boardLatency();
+		static bool loadLatency(const QString &path, IO::Latency &latency, QString &error);
+
 		IO(QObject *parent = nullptr);
 		~IO() override;
 
@@ -63,13 +94,35 @@ class IO : public QObject
 		IO &operator=(IO &&) = delete;
 
 		void reset();
+		void resetTransfer();
+
+		void setScheduler(Scheduler *scheduler);
+		void setLatency(const IO::Latency &latency);
+		const IO::Latency &getLatency() const;
+
+		void saveState(QDataStream &stream) const;
+		bool loadState(QDataStream &stream);
+
+		bool isOSLoaded() const;
+		unsigned long long getOperations() const;
 
 		void keyboardKeyPress(int key, Qt::KeyboardModifiers modifiers);
 		void ledSetRun(bool enable);
 		void ledSetError(bool enable);
+		void lcdSetFPS(int fps);
+		bool lcdContains(const QByteArray &text) const;
 		void rs232Receive(const QString &text);
+		int rs232ReceiveRaw(const QByteArray &data);
+		int rs232GetReceiveFree() const;
 		void rtcSetDateTime(const QDateTime &dateTime);
+		QDateTime rtcGetDateTime() const;
+		void rtcSetMode(RTC::Mode mode, const QDateTime &epoch);
 		void speakerSetVolume(unsigned int volume);
+		void speakerSetBandLimited(bool enable);
+		void speakerSetDeviceEnabled(bool enable);
+		bool speakerSetWavPath(const QString &path);
+		bool speakerIsPlaying();
+		void speakerClear();
 		void fsSetPath(const QString &path);
 
 	private:
@@ -95,7 +148,8 @@ class IO : public QObject
 			REG_LCD_CURSOR_POS_Y = 7, //!< LCD cursor vertical position register
 			REG_LCD_CHAR = 8, //!< LCD char register
 			REG_RS232 = 9, //!< RS232 register
-			REG_FS = 10 //!< File System register
+			REG_FS = 10, //!< File System register
+			REG_LCD_STRING = 11 //!< LCD string register, chars are buffered and printed with one refresh when zero is written
 		};
 
 		//! Low part commands
@@ -106,7 +160,11 @@ class IO : public QObject
 			FS_OPEN_APP = 2, //!< Open an application command
 			FS_OPEN_FILE = 3, //!< Open a file command
 			FS_LIST_APP = 4, //!< List files in the app directory
-			FS_LIST_FILE = 5 //!< List files in the file sirectory
+			FS_LIST_FILE = 5, //!< List files in the file sirectory
+			PERF_LATCH = 6, //!< Latch the tick and the instruction counters
+			FS_SEEK = 7, //!< Set the read position of the open file to the offset fields
+			FS_OPEN_STREAM = 8, //!< Open a file larger than the maximum file size, it is read in parts with seeking
+			FS_READ_BLOCK = 9 //!< Read the next block of the open file ahead, so its bytes are returned without waiting for the card
 		};
 
 		//! High part commands
@@ -157,6 +215,9 @@ class IO : public QObject
 		//! Writable fields
 		enum FieldW
 		{
+			FS_OFFSET_LOW = 0, //!< Low byte of the seek offset field
+			FS_OFFSET_MIDDLE = 1, //!< Middle byte of the seek offset field
+			FS_OFFSET_HIGH = 2, //!< High byte of the seek offset field
 			SPEAKER_NOTE = 12, //!< Code of a note to play field
 			SPEAKER_TIME = 13, //!< Play time of a note field
 			SPEAKER_FILL = 14, //!< Square fill of a note field
@@ -168,6 +229,8 @@ class IO : public QObject
 		{
 			FS_DATA_SIZE_LOW = 0, //!< Low byte of a file size field
 			FS_DATA_SIZE_HIGH = 1, //!< High byte of a file size field
+			PERF_COUNTER = 2, //!< Next byte of the latched counters field. Four bytes of ticks and four bytes of instructions, both little-endian.
+			FS_DATA_SIZE_EXT = 3, //!< Extended byte of a file size field, bits 16-23
 			SPEAKER_BUFFER_FREE = 12 //!< Free space size in the sound buffer field
 		};
 
@@ -188,11 +251,38 @@ class IO : public QObject
 			{
 				QString name; //!< Path buffer
 				FS::Size size; //!< Size buffer
+				unsigned char offset[FS_OFFSET_SIZE]; //!< Seek offset buffer, little-endian
 				bool status; //!< Status buffer
 			} fs; //!< File System buffer
+			struct
+			{
+				unsigned char counter[PERF_COUNTER_SIZE * 2]; //!< Latched tick and instruction counters
+				unsigned char position; //!< Position of the next byte to read from the latched counters
+				unsigned char value; //!< Byte of the latched counters which is being read
+			} perf; //!< Performance counters buffer
+			struct
+			{
+				QByteArray string; //!< Buffered chars of the string
+			} lcd; //!< LCD string buffer
 		} reg = {};
 
 		volatile unsigned char in = 0; //!< Input register buffer
+		QVector<unsigned char> readLatch = QVector<unsigned char>(REG_QUANTITY, 0); //!< Byte read by the low half for every register, it is returned in two halves
+		QVector<unsigned char> writeLatch = QVector<unsigned char>(REG_QUANTITY, 0); //!< Byte collected from the written halves for every register
+
+		unsigned long long ticks = 0; //!< Clock ticks of the CPU at the last IO operation
+		unsigned long long instructions = 0; //!< Executed instructions of the CPU at the last IO operation
+
+		bool osLoaded = false; //!< Status of opening the OS file by the BIOS
+		unsigned long long operations = 0; //!< Counter of processed IO operations
+		bool fsBlockRead = false; //!< Status of reading the last FS byte from the block read ahead
+		bool fsPrefetched = false; //!< Status of fetching the next FS byte by the IO board just after the last byte was streamed
+		unsigned long long fsPrefetchReady = 0; //!< Clock tick when the prefetched FS byte is ready
+		int lcdStringPrinted = 0; //!< Quantity of chars printed from the LCD string buffer by the last operation
+		bool lcdStringRefreshed = false; //!< Status of refreshing the LCD by the last LCD string write
+
+		Scheduler *scheduler = nullptr; //!< Scheduler of the CPU used to delay completion of operations
+		Latency latency; //!< Processing time model of the IO board
 
 		Keyboard keyboard; //!< Keyboard class instance used for emulation motherboard's IO part
 		LED led; //!< LED class instance used for emulation motherboard's IO part
@@ -203,7 +293,7 @@ class IO : public QObject
 		FS fs; //!< File System class instance used for emulation motherboard's IO part
 
 		unsigned char outReadStatus(bool half);
-		unsigned char outReadField();
+		unsigned char outReadField(bool half);
 		unsigned char outReadKeyboard(bool half);
 		unsigned char outReadLCDCursorPosX(bool half);
 		unsigned char outReadLCDCursorPosY(bool half);
@@ -220,15 +310,22 @@ class IO : public QObject
 		void outWriteLCDChar(bool half, unsigned char dataIn, unsigned char mask);
 		void outWriteCRS232Tx(bool half, unsigned char dataIn, unsigned char mask);
 		void outWriteFSName(bool half, unsigned char dataIn, unsigned char mask);
+		void outWriteLCDString(bool half, unsigned char dataIn, unsigned char mask);
+		void lcdFlushString();
+
+		unsigned int getOperationLatency(bool half, bool mode, bool rw, unsigned char dataInRaw) const;
+		void completeOperation();
 
 	signals:
 		void updateLEDRunSignal(bool enable);
 		void updateLEDErrorSignal(bool enable);
 
-		void updateLCDBufferSignal(LCD::Buffer buffer);
+		void updateLCDCellsSignal(LCD::Cells cells);
+		void updateLCDFramesSignal(unsigned long long submitted, unsigned long long presented);
 
-		void updateRS232TxSignal(unsigned char c);
-		void updateRS232RxSignal(unsigned char c);
+		void updateRS232TxSignal(const QByteArray &data);
+		void updateRS232RxSignal(const QByteArray &data);
+		void rs232ReceiveFreeSignal();
 
 		void updateRTCDateTimeSignal(QDateTime dateTime);
 
@@ -240,6 +337,7 @@ class IO : public QObject
 		void keyboardDataReadySlot(bool ready);
 		void rs232DataReadySlot(bool ready);
 
+		void counterSlot(unsigned long long ticks, unsigned long long instructions);
 		void outSlot(unsigned char out);
 };
 
@@ -125,3 +125,25 @@ unsigned char Keyboard::getKey()
 
 	return(0);
 }
+
+/**
+ * Save the keyboard buffer to the state stream
+ *
+ * @param stream State stream
+ */
+void Keyboard::saveState(QDataStream &stream) const
+{
+	stream << this->buffer;
+}
+
+/**
+ * Load the keyboard buffer from the state stream
+ *
+ * @param stream State stream
+ */
+void Keyboard::loadState(QDataStream &stream)
+{
+	stream >> this->buffer;
+
+	emit dataReadySignal(this->buffer.length() > 0);
+}
@@ -14,6 +14,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QDataStream>
 
 //! This class contains keyboard functions
 class Keyboard : public QObject
@@ -40,6 +41,9 @@ class Keyboard : public QObject
 
 		void reset();
 
+		void saveState(QDataStream &stream) const;
+		void loadState(QDataStream &stream);
+
 		void keyPress(int key, Qt::KeyboardModifiers modifiers);
 
 		unsigned char getKey();
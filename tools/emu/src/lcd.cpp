@@ -9,6 +9,8 @@
  * Code is free for non-commercial and commercial use.
  */
 
+#include <cstring>
+
 #include "lcd.h"
 
 /**
@@ -18,6 +20,14 @@
  */
 LCD::LCD(QObject *parent) : QObject(parent)
 {
+	std::memset(this->buffer[1].charData, 0, SIZE);
+	std::memset(this->buffer[1].colorData, 0, SIZE);
+
+	this->presentTimer.setTimerType(Qt::PreciseTimer);
+	this->setFPS(DEFAULT_FPS);
+
+	QObject::connect(&this->presentTimer, SIGNAL(timeout()), this, SLOT(presentSlot()));
+
 	this->reset();
 }
 
@@ -30,51 +40,95 @@ void LCD::reset()
 	this->color = DEFAULT_COLOR;
 	this->cursorPosX = 0;
 	this->cursorPosY = 0;
+
+	this->dirty.fill(true);
+
+	this->presentTimer.stop();
+	this->presentPending = false;
+	this->framesSubmitted = 0;
+	this->framesPresented = 0;
+
+	emit updateFramesSignal(this->framesSubmitted, this->framesPresented);
 }
 
-//! Clear the canvas painting buffer
-void LCD::clear()
+/**
+ * Set the maximum quantity of presented frames per second. Refreshes requested faster are merged into one frame.
+ *
+ * @param fps Frames per second, 0 presents every refresh immediately
+ */
+void LCD::setFPS(int fps)
 {
-	for(int i = 0; i < HEIGHT; i++)
+	if(fps > 0)
 	{
-		for(int j = 0; j < WIDTH; j++)
-		{
-			this->buffer[0].charData[i][j] = 0;
-			this->buffer[0].colorData[i][j] = 0;
-		}
+		this->presentTimer.setInterval(qMax(1, (1000 / fps)));
+	}
+	else
+	{
+		this->presentTimer.setInterval(0);
 	}
 }
 
-//! Copy data from the canvas painting buffer to the ready to show buffer
+/**
+ * Get the offset of the first char of a screen row in the canvas painting buffer
+ *
+ * @param y Screen row
+ *
+ * @return Offset in the canvas planes
+ */
+int LCD::getCanvasRow(int y) const
+{
+	return(((this->canvasTop + y) % HEIGHT) * WIDTH);
+}
+
+//! Clear the canvas painting buffer
+void LCD::clear()
+{
+	std::memset(this->buffer[0].charData, 0, SIZE);
+	std::memset(this->buffer[0].colorData, 0, SIZE);
+
+	this->canvasTop = 0;
+}
+
+//! Copy data from the canvas painting buffer to the ready to show buffer. Rows are compared as a whole and only the changed chars are marked as dirty.
 void LCD::refresh()
 {
-	for(int i = 0; i < HEIGHT; i++)
+	for(int y = 0; y < HEIGHT; y++)
 	{
-		for(int j = 0; j < WIDTH; j++)
+		const int srcRow = this->getCanvasRow(y);
+		const int dstRow = (y * WIDTH);
+
+		const unsigned char *srcChar = &this->buffer[0].charData[srcRow];
+		const unsigned char *srcColor = &this->buffer[0].colorData[srcRow];
+		unsigned char *dstChar = &this->buffer[1].charData[dstRow];
+		unsigned char *dstColor = &this->buffer[1].colorData[dstRow];
+
+		if((std::memcmp(dstChar, srcChar, WIDTH) == 0) && (std::memcmp(dstColor, srcColor, WIDTH) == 0))
 		{
-			this->buffer[1].charData[i][j] = this->buffer[0].charData[i][j];
-			this->buffer[1].colorData[i][j] = this->buffer[0].colorData[i][j];
+			continue;
 		}
-	}
-}
 
-//! Scroll the canvas painting buffer one line up
-void LCD::scrollDown()
-{
-	for(int y = 0; y < (HEIGHT - 1); y++)
-	{
 		for(int x = 0; x < WIDTH; x++)
 		{
-			this->buffer[0].charData[y][x] = this->buffer[0].charData[y + 1][x];
-			this->buffer[0].colorData[y][x] = this->buffer[0].colorData[y + 1][x];
+			if((dstChar[x] != srcChar[x]) || (dstColor[x] != srcColor[x]))
+			{
+				this->dirty.setBit(dstRow + x);
+			}
 		}
-	}
 
-	for(int x = 0; x < WIDTH; x++)
-	{
-		this->buffer[0].charData[HEIGHT - 1][x] = 0;
-		this->buffer[0].colorData[HEIGHT - 1][x] = 0;
+		std::memcpy(dstChar, srcChar, WIDTH);
+		std::memcpy(dstColor, srcColor, WIDTH);
 	}
+}
+
+//! Scroll the canvas painting buffer one line up. The top row is cleared and becomes the bottom one.
+void LCD::scrollDown()
+{
+	const int row = this->getCanvasRow(0);
+
+	std::memset(&this->buffer[0].charData[row], 0, WIDTH);
+	std::memset(&this->buffer[0].colorData[row], 0, WIDTH);
+
+	this->canvasTop = ((this->canvasTop + 1) % HEIGHT);
 
 	if(this->cursorPosY > 0)
 	{
@@ -162,6 +216,28 @@ unsigned char LCD::getCursorPosY()
 	return(this->cursorPosY);
 }
 
+/**
+ * Check if the refreshed screen shows the text in one row. Empty chars match spaces.
+ *
+ * @param text Text to find
+ *
+ * @return Status of finding the text
+ */
+bool LCD::contains(const QByteArray &text) const
+{
+	for(int y = 0; y < HEIGHT; y++)
+	{
+		QByteArray row(reinterpret_cast<const char *>(&this->buffer[1].charData[y * WIDTH]), WIDTH);
+
+		if(row.replace('\0', ' ').contains(text))
+		{
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
 /**
  * Print a character
  *
@@ -181,14 +257,154 @@ void LCD::printChar(unsigned char c)
 		this->cursorPosY = (HEIGHT - 1);
 	}
 
-	this->buffer[0].charData[this->cursorPosY][this->cursorPosX] = c;
-	this->buffer[0].colorData[this->cursorPosY][this->cursorPosX] = this->color;
+	const int i = (this->getCanvasRow(this->cursorPosY) + this->cursorPosX);
+
+	this->buffer[0].charData[i] = c;
+	this->buffer[0].colorData[i] = this->color;
 
 	this->cursorPosX++;
 }
 
-//! Emit the update signal with ready to show buffer data
+/**
+ * Print a string at the cursor position. Chars are copied to the canvas in runs which end at the end of a row.
+ *
+ * @param s String to print
+ */
+void LCD::printString(const QByteArray &s)
+{
+	int i = 0;
+
+	while(i < s.size())
+	{
+		if(this->cursorPosX >= WIDTH)
+		{
+			this->cursorPosX = 0;
+			this->cursorPosY++;
+		}
+
+		if(this->cursorPosY >= HEIGHT)
+		{
+			this->scrollDown();
+			this->cursorPosY = (HEIGHT - 1);
+		}
+
+		const int run = qMin((WIDTH - this->cursorPosX), (s.size() - i));
+		const int pos = (this->getCanvasRow(this->cursorPosY) + this->cursorPosX);
+
+		std::memcpy(&this->buffer[0].charData[pos], (s.constData() + i), static_cast<size_t>(run));
+		std::memset(&this->buffer[0].colorData[pos], this->color, static_cast<size_t>(run));
+
+		this->cursorPosX = static_cast<unsigned char>(this->cursorPosX + run);
+		i += run;
+	}
+}
+
+//! Request presenting of the ready to show buffer. When the frame period is not over yet, the buffer is presented at its end together with all later refreshes.
 void LCD::update()
 {
-	emit updateBufferSignal(this->buffer[1]);
+	this->framesSubmitted++;
+
+	if(this->presentTimer.interval() == 0)
+	{
+		this->present();
+		return;
+	}
+
+	this->presentPending = true;
+
+	if(!this->presentTimer.isActive())
+	{
+		this->present();
+		this->presentTimer.start();
+	}
+}
+
+//! Present the pending buffer at the end of the frame period. The timer is stopped when the guest does not refresh the LCD anymore.
+void LCD::presentSlot()
+{
+	if(this->presentPending)
+	{
+		this->present();
+	}
+	else
+	{
+		this->presentTimer.stop();
+	}
+}
+
+//! Emit the update signal with chars of the ready to show buffer changed since the last presented frame
+void LCD::present()
+{
+	this->presentPending = false;
+	this->framesPresented++;
+
+	Cells cells;
+
+	for(int i = 0; i < SIZE; i++)
+	{
+		if(this->dirty.testBit(i))
+		{
+			Cell cell = {};
+
+			cell.x = static_cast<unsigned char>(i % WIDTH);
+			cell.y = static_cast<unsigned char>(i / WIDTH);
+			cell.c = this->buffer[1].charData[i];
+			cell.color = this->buffer[1].colorData[i];
+
+			cells.append(cell);
+		}
+	}
+
+	this->dirty.fill(false);
+
+	if(!cells.isEmpty())
+	{
+		emit updateCellsSignal(cells);
+	}
+
+	emit updateFramesSignal(this->framesSubmitted, this->framesPresented);
+}
+
+/**
+ * Save the LCD buffers, the color and the cursor position to the state stream. Rows of the canvas are saved in the screen order.
+ *
+ * @param stream State stream
+ */
+void LCD::saveState(QDataStream &stream) const
+{
+	for(int y = 0; y < HEIGHT; y++)
+	{
+		stream.writeRawData(reinterpret_cast<const char *>(&this->buffer[0].charData[this->getCanvasRow(y)]), WIDTH);
+	}
+
+	for(int y = 0; y < HEIGHT; y++)
+	{
+		stream.writeRawData(reinterpret_cast<const char *>(&this->buffer[0].colorData[this->getCanvasRow(y)]), WIDTH);
+	}
+
+	stream.writeRawData(reinterpret_cast<const char *>(this->buffer[1].charData), SIZE);
+	stream.writeRawData(reinterpret_cast<const char *>(this->buffer[1].colorData), SIZE);
+
+	stream << this->color << this->cursorPosX << this->cursorPosY;
+}
+
+/**
+ * Load the LCD buffers, the color and the cursor position from the state stream and show the loaded screen
+ *
+ * @param stream State stream
+ */
+void LCD::loadState(QDataStream &stream)
+{
+	for(Buffer &buffer : this->buffer)
+	{
+		stream.readRawData(reinterpret_cast<char *>(buffer.charData), SIZE);
+		stream.readRawData(reinterpret_cast<char *>(buffer.colorData), SIZE);
+	}
+
+	this->canvasTop = 0;
+
+	stream >> this->color >> this->cursorPosX >> this->cursorPosY;
+
+	this->dirty.fill(true);
+	this->update();
 }
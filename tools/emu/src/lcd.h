@@ -14,6 +14,10 @@
 
 #include <QObject>
 #include <QVector>
+#include <QBitArray>
+#include <QDataStream>
+#include <QTimer>
+#include <QByteArray>
 
 #ifdef CHAR_WIDTH
 #undef CHAR_WIDTH
@@ -30,6 +34,7 @@ class LCD : public QObject
 
 		static const int WIDTH = 40; //!< Chars per row
 		static const int HEIGHT = 30; //!< Chars per column
+		static const int SIZE = (WIDTH * HEIGHT); //!< Chars per screen
 
 		static const int COLOR_MASK_FOREGROUND = 0x0f; //!< Foreground color mask
 		static const int COLOR_MASK_BACKGROUND = 0xf0; //!< Background color mask
@@ -37,17 +42,33 @@ class LCD : public QObject
 
 		static const unsigned char DEFAULT_COLOR = 0x0f; //!< Default foreground and background colors
 
-		//! LCD buffer
+		static const int DEFAULT_FPS = 60; //!< Default maximum quantity of presented frames per second
+
+		//! LCD buffer with flat planes, rows follow one another
 		struct Buffer
 		{
-			QVector<QVector<unsigned char>> charData = QVector<QVector<unsigned char>>(HEIGHT, QVector<unsigned char>(WIDTH)); //!< Character buffer
-			QVector<QVector<unsigned char>> colorData = QVector<QVector<unsigned char>>(HEIGHT, QVector<unsigned char>(WIDTH)); //!< Background and foreground color buffer
+			unsigned char charData[SIZE]; //!< Character plane
+			unsigned char colorData[SIZE]; //!< Background and foreground color plane
+		};
+
+		//! Changed char of the ready to show buffer
+		struct Cell
+		{
+			unsigned char x; //!< Horizontal position
+			unsigned char y; //!< Vertical position
+			unsigned char c; //!< Char
+			unsigned char color; //!< Background and foreground colors
 		};
 
+		typedef QVector<Cell> Cells; //!< List of changed chars sorted by rows
+
 		LCD(QObject *parent = nullptr);
 
 		void reset();
 
+		void saveState(QDataStream &stream) const;
+		void loadState(QDataStream &stream);
+
 		void clear();
 		void refresh();
 		void scrollDown();
@@ -61,19 +82,40 @@ class LCD : public QObject
 		unsigned char getCursorPosX();
 		unsigned char getCursorPosY();
 
+		bool contains(const QByteArray &text) const;
+
 		void printChar(unsigned char c);
+		void printString(const QByteArray &s);
 
 		void update();
 
+		void setFPS(int fps);
+
 	private:
-		QVector<Buffer> buffer = { Buffer(), Buffer() }; //!< First buffer is using as canvas for painting, the second one is a copy ready to show
+		Buffer buffer[2]; //!< First buffer is using as canvas for painting, the second one is a copy ready to show
+		int canvasTop; //!< Row of the canvas painting buffer shown at the top of the screen, the canvas is a ring of rows so scrolling only moves this offset
 
 		unsigned char color; //!< Current set foreground and background colors
 		unsigned char cursorPosX; //!< Current horizontal cursor position
 		unsigned char cursorPosY; //!< Current vertical cursor position
 
+		QBitArray dirty = QBitArray(SIZE); //!< Chars of the ready to show buffer changed since the last update
+
+		QTimer presentTimer; //!< Timer used to present the refreshed buffer at most once per frame period
+		bool presentPending; //!< Status of waiting for the next frame period to present the refreshed buffer
+		unsigned long long framesSubmitted; //!< Counter of refreshes requested by the guest
+		unsigned long long framesPresented; //!< Counter of refreshes really sent to the view, the rest were superseded
+
+		int getCanvasRow(int y) const;
+
+		void present();
+
+	private slots:
+		void presentSlot();
+
 	signals:
-		void updateBufferSignal(LCD::Buffer buffer);
+		void updateCellsSignal(LCD::Cells cells);
+		void updateFramesSignal(unsigned long long submitted, unsigned long long presented);
 };
 
 #endif
@@ -0,0 +1,194 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "lcdcapture.h"
+
+/**
+ * Constructor for the LCD capture class
+ *
+ * @param parent Parent object
+ */
+LCDCapture::LCDCapture(QObject *parent) : QObject(parent)
+{
+	std::memset(this->buffer.charData, 0, LCD::SIZE);
+	std::memset(this->buffer.colorData, 0, LCD::SIZE);
+
+	this->textEveryFrame = false;
+	this->recordEnabled = false;
+	this->frame = 0;
+	this->finished = false;
+}
+
+//! Destructor for the LCD capture class. It writes the last text dump and all waiting frames.
+LCDCapture::~LCDCapture()
+{
+	this->finishSlot();
+}
+
+/**
+ * Set the file for the text dump
+ *
+ * @param path Path to the file, "-" is the standard output
+ * @param everyFrame Write the dump after every presented frame instead of only at the end
+ *
+ * @return Status of opening the file
+ */
+bool LCDCapture::setTextPath(const QString &path, bool everyFrame)
+{
+	this->textEveryFrame = everyFrame;
+
+	if(path == "-")
+	{
+		return(this->textFile.open(stdout, QIODevice::WriteOnly));
+	}
+
+	this->textFile.setFileName(path);
+
+	return(this->textFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+}
+
+/**
+ * Set the directory for the recorded frames and start the recording
+ *
+ * @param path Path to the directory
+ *
+ * @return Status of preparing the directory
+ */
+bool LCDCapture::setRecordPath(const QString &path)
+{
+	this->recordEnabled = this->recorder.setPath(path);
+
+	return(this->recordEnabled);
+}
+
+/**
+ * Write the current buffer to the text dump.
+ * It contains a header with the frame number, the rows of chars in UTF-8 and the rows of colors as two hex digits per char: background and foreground.
+ */
+void LCDCapture::writeText()
+{
+	QTextStream stream(&this->textFile);
+	stream.setCodec("UTF-8");
+
+	stream << "frame " << this->frame << "\n";
+
+	for(int y = 0; y < LCD::HEIGHT; y++)
+	{
+		QString row;
+
+		for(int x = 0; x < LCD::WIDTH; x++)
+		{
+			unsigned char c = this->buffer.charData[(y * LCD::WIDTH) + x];
+
+			if(c == 0)
+			{
+				row.append(QChar(' '));
+			}
+			else if((c >= 0x20) && (c < 0x7f))
+			{
+				row.append(QChar(c));
+			}
+			else
+			{
+				row.append(QChar(0x00b7));
+			}
+		}
+
+		stream << row << "\n";
+	}
+
+	for(int y = 0; y < LCD::HEIGHT; y++)
+	{
+		for(int x = 0; x < LCD::WIDTH; x++)
+		{
+			stream << QString("%1").arg(this->buffer.colorData[(y * LCD::WIDTH) + x], 2, 16, QChar('0'));
+		}
+
+		stream << "\n";
+	}
+
+	stream << "\n";
+	stream.flush();
+
+	this->textFile.flush();
+}
+
+/**
+ * Update the copy of the LCD buffer with changed chars of a presented frame
+ *
+ * @param cells Changed chars
+ */
+void LCDCapture::drawSlot(LCD::Cells cells)
+{
+	if(this->finished)
+	{
+		return;
+	}
+
+	for(const LCD::Cell &cell : cells)
+	{
+		const int i = ((cell.y * LCD::WIDTH) + cell.x);
+
+		this->buffer.charData[i] = cell.c;
+		this->buffer.colorData[i] = cell.color;
+
+		if(this->recordEnabled)
+		{
+			this->renderer.drawCell(cell.x, cell.y, cell.c, cell.color);
+		}
+	}
+
+	this->frame++;
+
+	if(this->textEveryFrame && this->textFile.isOpen())
+	{
+		this->writeText();
+	}
+
+	if(this->recordEnabled)
+	{
+		this->recorder.push(this->frame, this->renderer.getImage());
+	}
+}
+
+//! Write the last text dump and wait for the recorded frames. It is called once at the end of the emulation.
+void LCDCapture::finishSlot()
+{
+	if(this->finished)
+	{
+		return;
+	}
+
+	this->finished = true;
+
+	if(this->textFile.isOpen())
+	{
+		if(!this->textEveryFrame)
+		{
+			this->writeText();
+		}
+
+		this->textFile.close();
+	}
+
+	if(this->recordEnabled)
+	{
+		this->recorder.finish();
+
+		if(this->recorder.getDropped() > 0)
+		{
+			qWarning("LCD recorder dropped %llu frames", this->recorder.getDropped());
+		}
+	}
+}
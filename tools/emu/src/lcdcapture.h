@@ -0,0 +1,62 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef LCDCAPTURE_H
+#define LCDCAPTURE_H
+
+#include <QObject>
+#include <QString>
+#include <QFile>
+#include <QTextStream>
+
+#include "lcd.h"
+#include "lcdrenderer.h"
+#include "lcdrecorder.h"
+
+//! This class contains a capture of the presented LCD frames as a text dump and as PNG files. It is used by the headless runs.
+class LCDCapture : public QObject
+{
+	Q_OBJECT
+
+	public:
+		LCDCapture(QObject *parent = nullptr);
+		~LCDCapture() override;
+
+		LCDCapture(const LCDCapture &) = delete;
+		LCDCapture &operator=(const LCDCapture &) = delete;
+		LCDCapture(LCDCapture &&) = delete;
+		LCDCapture &operator=(LCDCapture &&) = delete;
+
+		bool setTextPath(const QString &path, bool everyFrame);
+		bool setRecordPath(const QString &path);
+
+	private:
+		LCD::Buffer buffer; //!< Copy of the presented LCD buffer
+
+		QFile textFile; //!< File of the text dump, it can be the standard output
+		bool textEveryFrame; //!< Status of writing the text dump after every presented frame instead of only at the end
+
+		LCDRenderer renderer; //!< Renderer of the recorded frames
+		LCDRecorder recorder; //!< Encoder of the recorded frames
+		bool recordEnabled; //!< Status of recording frames to PNG files
+
+		unsigned long long frame; //!< Counter of the presented frames
+
+		bool finished; //!< Status of finished capture
+
+		void writeText();
+
+	public slots:
+		void drawSlot(LCD::Cells cells);
+		void finishSlot();
+};
+
+#endif
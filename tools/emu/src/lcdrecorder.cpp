@@ -0,0 +1,131 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "lcdrecorder.h"
+
+/**
+ * Constructor for the LCD recorder class
+ *
+ * @param parent Parent object
+ */
+LCDRecorder::LCDRecorder(QObject *parent) : QThread(parent)
+{
+	this->finishing = false;
+	this->dropped = 0;
+}
+
+//! Destructor for the LCD recorder class. It writes all waiting frames.
+LCDRecorder::~LCDRecorder()
+{
+	this->finish();
+}
+
+/**
+ * Set the directory for the PNG files and start the encoding thread
+ *
+ * @param path Path to the directory, it is created if needed
+ *
+ * @return Status of preparing the directory
+ */
+bool LCDRecorder::setPath(const QString &path)
+{
+	if(!QDir().mkpath(path))
+	{
+		return(false);
+	}
+
+	this->dir = QDir(path);
+
+	if(!this->isRunning())
+	{
+		this->start(QThread::LowPriority);
+	}
+
+	return(true);
+}
+
+/**
+ * Add a frame to the encoding queue. The image is shared, so it is not copied until the caller changes it.
+ *
+ * @param number Number of the frame used in the file name
+ * @param image Image of the frame
+ *
+ * @return Status of adding the frame, false when the queue is full and the frame is dropped
+ */
+bool LCDRecorder::push(unsigned long long number, const QImage &image)
+{
+	QMutexLocker locker(&this->mutex);
+
+	if(this->queue.size() >= QUEUE_SIZE)
+	{
+		this->dropped++;
+		return(false);
+	}
+
+	Frame frame = {number, image};
+
+	this->queue.enqueue(frame);
+	this->condition.wakeOne();
+
+	return(true);
+}
+
+//! Write all waiting frames and stop the encoding thread
+void LCDRecorder::finish()
+{
+	{
+		QMutexLocker locker(&this->mutex);
+
+		this->finishing = true;
+		this->condition.wakeOne();
+	}
+
+	this->wait();
+}
+
+/**
+ * Get the quantity of frames dropped because of the full queue
+ *
+ * @return Quantity of dropped frames
+ */
+unsigned long long LCDRecorder::getDropped() const
+{
+	QMutexLocker locker(&this->mutex);
+
+	return(this->dropped);
+}
+
+//! Encode frames from the queue until the recording is finished
+void LCDRecorder::run()
+{
+	forever
+	{
+		Frame frame;
+
+		{
+			QMutexLocker locker(&this->mutex);
+
+			while(this->queue.isEmpty() && (!this->finishing))
+			{
+				this->condition.wait(&this->mutex);
+			}
+
+			if(this->queue.isEmpty())
+			{
+				return;
+			}
+
+			frame = this->queue.dequeue();
+		}
+
+		frame.image.save(this->dir.filePath(QString("frame_%1.png").arg(frame.number, 6, 10, QChar('0'))), "PNG");
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef LCDRECORDER_H
+#define LCDRECORDER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QImage>
+#include <QString>
+#include <QDir>
+
+//! This class contains a recorder of the LCD frames to PNG files. Frames are encoded on a separate thread, so the emulation never waits for the disk.
+class LCDRecorder : public QThread
+{
+	Q_OBJECT
+
+	public:
+		static const int QUEUE_SIZE = 16; //!< Maximum quantity of frames waiting for encoding, next frames are dropped
+
+		LCDRecorder(QObject *parent = nullptr);
+		~LCDRecorder() override;
+
+		LCDRecorder(const LCDRecorder &) = delete;
+		LCDRecorder &operator=(const LCDRecorder &) = delete;
+		LCDRecorder(LCDRecorder &&) = delete;
+		LCDRecorder &operator=(LCDRecorder &&) = delete;
+
+		bool setPath(const QString &path);
+
+		bool push(unsigned long long number, const QImage &image);
+		void finish();
+
+		unsigned long long getDropped() const;
+
+	private:
+		//! Frame waiting for encoding
+		struct Frame
+		{
+			unsigned long long number; //!< Number of the frame used in the file name
+			QImage image; //!< Image of the frame
+		};
+
+		QDir dir; //!< Directory for the PNG files
+
+		mutable QMutex mutex; //!< Mutex protecting the queue and the flags
+		QWaitCondition condition; //!< Condition used to wake up the encoding thread
+		QQueue<Frame> queue; //!< Frames waiting for encoding
+		bool finishing; //!< Status of finishing the recording, the thread ends when the queue is empty
+		unsigned long long dropped; //!< Counter of frames dropped because of the full queue
+
+		void run() override;
+};
+
+#endif
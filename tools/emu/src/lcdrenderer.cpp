@@ -0,0 +1,85 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "lcdrenderer.h"
+#include "font.h"
+
+//! Constructor for the LCD renderer class. It prepares the palette and the pixel masks.
+LCDRenderer::LCDRenderer() : image(WIDTH, HEIGHT, QImage::Format_RGB32)
+{
+	for(int color = 0; color < COLOR_QUANTITY; color++)
+	{
+		int blue = ((color & (1 << 0)) ? 170 : 0) + ((color & (1 << 3)) ? 85 : 0);
+		int green = ((color & (1 << 1)) ? 180 : 0) + ((color & (1 << 3)) ? 75 : 0);
+		int red = ((color & (1 << 2)) ? 180 : 0) + ((color & (1 << 3)) ? 75 : 0);
+
+		this->palette[color] = qRgb(red, green, blue);
+	}
+
+	for(int b = 0; b < FONT_QUANTITY; b++)
+	{
+		for(int i = 0; i < LCD::CHAR_WIDTH; i++)
+		{
+			this->mask[(b * LCD::CHAR_WIDTH) + i] = ((b & (0x80 >> i)) ? 0xffffffff : 0x00000000);
+		}
+	}
+
+	for(int c = 0; c < FONT_QUANTITY; c++)
+	{
+		this->glyph[c] = fontTable[c].constData();
+	}
+
+	this->reset();
+}
+
+//! Fill the image with black color
+void LCDRenderer::reset()
+{
+	this->image.fill(QColor(0, 0, 0));
+}
+
+/**
+ * Draw a single char on the image
+ *
+ * @param x Horizontal position of the char
+ * @param y Vertical position of the char
+ * @param c Char to draw
+ * @param color Background and foreground colors of the char
+ */
+void LCDRenderer::drawCell(int x, int y, unsigned char c, unsigned char color)
+{
+	QRgb foreground = this->palette[color & LCD::COLOR_MASK_FOREGROUND];
+	QRgb background = this->palette[(color & LCD::COLOR_MASK_BACKGROUND) >> LCD::COLOR_SHIFT];
+	QRgb difference = (foreground ^ background);
+
+	const unsigned char *rows = this->glyph[c];
+
+	for(int j = 0; j < LCD::CHAR_HEIGHT; j++)
+	{
+		QRgb *line = (reinterpret_cast<QRgb *>(this->image.scanLine((y * LCD::CHAR_HEIGHT) + j)) + (x * LCD::CHAR_WIDTH));
+		const QRgb *rowMask = (this->mask.constData() + (rows[j] * LCD::CHAR_WIDTH));
+
+		for(int i = 0; i < LCD::CHAR_WIDTH; i++)
+		{
+			line[i] = (background ^ (difference & rowMask[i]));
+		}
+	}
+}
+
+/**
+ * Get the rendered image
+ *
+ * @return Rendered image
+ */
+const QImage &LCDRenderer::getImage() const
+{
+	return(this->image);
+}
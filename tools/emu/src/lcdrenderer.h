@@ -0,0 +1,47 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef LCDRENDERER_H
+#define LCDRENDERER_H
+
+#include <QVector>
+#include <QImage>
+#include <QColor>
+
+#include "lcd.h"
+
+//! This class contains a renderer of the LCD characters to an image. It uses a palette and a pixel mask for every byte of the font.
+class LCDRenderer
+{
+	public:
+		static const int WIDTH = (LCD::CHAR_WIDTH * LCD::WIDTH); //!< Horizontal resolution
+		static const int HEIGHT = (LCD::CHAR_HEIGHT * LCD::HEIGHT); //!< Vertical resolution
+
+		static const int COLOR_QUANTITY = 16; //!< Quantity of colors in the palette
+		static const int FONT_QUANTITY = 256; //!< Quantity of chars in the font
+
+		LCDRenderer();
+
+		void reset();
+
+		void drawCell(int x, int y, unsigned char c, unsigned char color);
+
+		const QImage &getImage() const;
+
+	private:
+		QVector<QRgb> palette = QVector<QRgb>(COLOR_QUANTITY); //!< Colors of the LCD
+		QVector<QRgb> mask = QVector<QRgb>(FONT_QUANTITY * LCD::CHAR_WIDTH); //!< Pixel masks for every byte of the font, all bits are set for the foreground pixels
+		QVector<const unsigned char *> glyph = QVector<const unsigned char *>(FONT_QUANTITY); //!< Rows of every char of the font
+
+		QImage image; //!< Rendered image of the whole LCD
+};
+
+#endif
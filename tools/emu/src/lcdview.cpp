@@ -10,7 +10,6 @@
  */
 
 #include "lcdview.h"
-#include "font.h"
 
 /**
  * Constructor for the LCD view class
@@ -21,24 +20,18 @@ LCDView::LCDView(QWidget *parent) : QGraphicsView(parent)
 {
 	this->scene.reset(new QGraphicsScene(QRect(0, 0, WIDTH, HEIGHT), this));
 
-	QPixmap pixmap = QPixmap(WIDTH, HEIGHT);
-	pixmap.fill(QColor(0, 0, 0));
-
-	this->pixmapItem = this->scene->addPixmap(pixmap);
-
 	this->scale(2, 2);
 	this->setScene(this->scene.data());
 	this->setBackgroundBrush(QBrush(QColor(0, 0, 0), Qt::SolidPattern));
 	this->show();
 }
 
-//! Reset the LCD view pixmap canvas
+//! Reset the LCD view canvas
 void LCDView::reset()
 {
-	QImage image = QImage(WIDTH, HEIGHT, QImage::Format_RGB32);
-	image.fill(QColor(0, 0, 0));
+	this->renderer.reset();
 
-	this->pixmapItem->setPixmap(QPixmap::fromImage(image));
+	this->scene->invalidate(this->scene->sceneRect(), QGraphicsScene::BackgroundLayer);
 }
 
 /**
@@ -55,51 +48,50 @@ void LCDView::mousePressEvent(QMouseEvent *)
 }
 
 /**
- * Draw a LCD buffer on the LCD view canvas
+ * Paint the rendered LCD image as the scene background. Only the exposed part of the image is painted.
+ *
+ * @param painter Painter of the view
+ * @param rect Exposed area in the scene coordinates
+ */
+void LCDView::drawBackground(QPainter *painter, const QRectF &rect)
+{
+	QGraphicsView::drawBackground(painter, rect);
+
+	QRect area = rect.toAlignedRect().intersected(QRect(0, 0, WIDTH, HEIGHT));
+
+	if(!area.isEmpty())
+	{
+		painter->drawImage(area, this->renderer.getImage(), area);
+	}
+}
+
+/**
+ * Draw changed LCD chars on the LCD view canvas and repaint only the rows they belong to
  *
- * @param buffer LCD buffer
+ * @param cells Changed chars sorted by rows
  */
-void LCDView::drawSlot(LCD::Buffer buffer)
+void LCDView::drawSlot(LCD::Cells cells)
 {
-	QImage image = QImage(WIDTH, HEIGHT, QImage::Format_RGB32);
-	image.fill(QColor(0, 0, 0));
+	int i = 0;
 
-	for(int x = 0; x < LCD::WIDTH; x++)
+	while(i < cells.size())
 	{
-		for(int y = 0; y < LCD::HEIGHT; y++)
+		int y = cells[i].y;
+		int minX = cells[i].x;
+		int maxX = cells[i].x;
+
+		for(; (i < cells.size()) && (cells[i].y == y); i++)
 		{
-			unsigned char c = buffer.charData[y][x];
-			unsigned char colorChar = (buffer.colorData[y][x] & LCD::COLOR_MASK_FOREGROUND);
-			unsigned char colorBackground = ((buffer.colorData[y][x] & LCD::COLOR_MASK_BACKGROUND) >> LCD::COLOR_SHIFT);
-
-			unsigned char colorCharBlue = ((colorChar & (1 << 0)) ? 170 : 0) + ((colorChar & (1 << 3)) ? 85 : 0);
-			unsigned char colorCharGreen = ((colorChar & (1 << 1)) ? 180 : 0) + ((colorChar & (1 << 3)) ? 75 : 0);
-			unsigned char colorCharRed = ((colorChar & (1 << 2)) ? 180 : 0) + ((colorChar & (1 << 3)) ? 75 : 0);
-
-			unsigned char colorBackgroundBlue = ((colorBackground & (1 << 0)) ? 170 : 0) + ((colorBackground & (1 << 3)) ? 85 : 0);
-			unsigned char colorBackgroundGreen = ((colorBackground & (1 << 1)) ? 180 : 0) + ((colorBackground & (1 << 3)) ? 75 : 0);
-			unsigned char colorBackgroundRed = ((colorBackground & (1 << 2)) ? 180 : 0) + ((colorBackground & (1 << 3)) ? 75 : 0);
-
-			for(int j = 0; j < LCD::CHAR_HEIGHT; j++)
-			{
-				unsigned char b = fontTable[c][j];
-
-				for(int i = 0; i < LCD::CHAR_WIDTH; i++)
-				{
-					if(b & 0x80)
-					{
-						image.setPixelColor(((x * LCD::CHAR_WIDTH) + i), ((y * LCD::CHAR_HEIGHT) + j), QColor(colorCharRed, colorCharGreen, colorCharBlue));
-					}
-					else
-					{
-						image.setPixelColor(((x * LCD::CHAR_WIDTH) + i), ((y * LCD::CHAR_HEIGHT) + j), QColor(colorBackgroundRed, colorBackgroundGreen, colorBackgroundBlue));
-					}
-
-					b <<= 1;
-				}
-			}
+			const LCD::Cell &cell = cells[i];
+
+			this->renderer.drawCell(cell.x, cell.y, cell.c, cell.color);
+
+			minX = qMin(minX, static_cast<int>(cell.x));
+			maxX = qMax(maxX, static_cast<int>(cell.x));
 		}
-	}
 
-	this->pixmapItem->setPixmap(QPixmap::fromImage(image));
+		QRectF rowRect = QRectF(minX * LCD::CHAR_WIDTH, y * LCD::CHAR_HEIGHT, ((maxX - minX) + 1) * LCD::CHAR_WIDTH, LCD::CHAR_HEIGHT);
+
+		this->scene->invalidate(rowRect, QGraphicsScene::BackgroundLayer);
+	}
 }
@@ -14,13 +14,13 @@
 
 #include <QGraphicsView>
 #include <QGraphicsScene>
-#include <QPixmap>
-#include <QGraphicsPixmapItem>
 #include <QImage>
+#include <QPainter>
 #include <QMouseEvent>
 #include <QScopedPointer>
 
 #include "lcd.h"
+#include "lcdrenderer.h"
 
 //! This class contains LCD view using to present LCD data on UI
 class LCDView : public QGraphicsView
@@ -37,12 +37,13 @@ class LCDView : public QGraphicsView
 
 	private:
 		QScopedPointer<QGraphicsScene> scene; //!< Scene used to rendering
-		QGraphicsPixmapItem *pixmapItem; //!< Pixel buffer used as a canvas to paint the console
+		LCDRenderer renderer; //!< Renderer of the LCD chars
 
 		void mousePressEvent(QMouseEvent *event) override;
+		void drawBackground(QPainter *painter, const QRectF &rect) override;
 
 	public slots:
-		void drawSlot(LCD::Buffer buffer);
+		void drawSlot(LCD::Cells cells);
 };
 
 #endif
@@ -69,3 +69,29 @@ bool LED::getError()
 {
 	return(this->error);
 }
+
+/**
+ * Save the statuses of LEDs to the state stream
+ *
+ * @param stream State stream
+ */
+void LED::saveState(QDataStream &stream) const
+{
+	stream << this->run << this->error;
+}
+
+/**
+ * Load the statuses of LEDs from the state stream
+ *
+ * @param stream State stream
+ */
+void LED::loadState(QDataStream &stream)
+{
+	bool run = false;
+	bool error = false;
+
+	stream >> run >> error;
+
+	this->setRun(run);
+	this->setError(error);
+}
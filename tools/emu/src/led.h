@@ -13,6 +13,7 @@
 #define LED_H
 
 #include <QObject>
+#include <QDataStream>
 
 //! This class contains status LED functions
 class LED : public QObject
@@ -24,6 +25,9 @@ class LED : public QObject
 
 		void reset();
 
+		void saveState(QDataStream &stream) const;
+		void loadState(QDataStream &stream);
+
 		void setRun(bool enable);
 		void setError(bool enable);
 
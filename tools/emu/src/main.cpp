@@ -16,6 +16,32 @@
 
 #include "emu.h"
 
+/**
+ * Parse a number given by an option
+ *
+ * @param parser Parser of the arguments
+ * @param option Option with the number
+ * @param min Minimum allowed value
+ * @param max Maximum allowed value
+ * @param value Parsed value
+ *
+ * @return Status of parsing the number, the error is printed when the value is bad
+ */
+static bool parseNumber(const QCommandLineParser &parser, const QCommandLineOption &option, long long min, long long max, long long &value)
+{
+	bool ok;
+
+	value = parser.value(option).toLongLong(&ok);
+
+	if((!ok) || (value < min) || (value > max))
+	{
+		qCritical("Error: Bad value of the --%s option, use a number from %lld to %lld", qPrintable(option.names().first()), min, max);
+		return(false);
+	}
+
+	return(true);
+}
+
 /**
  * Main entry function of the application
  *
@@ -32,6 +58,82 @@ int main(int argc, char *argv[])
 	parser.setApplicationDescription("Emulator of the XiPC v2");
 	parser.addHelpOption();
 	parser.addVersionOption();
+
+	QCommandLineOption ioLatencyOption("io-latency", "Emulate processing time of the IO board");
+	parser.addOption(ioLatencyOption);
+
+	QCommandLineOption ioLatencyTableOption("io-latency-table", "Emulate processing time of the IO board with costs changed by the key=ticks table file", "path");
+	parser.addOption(ioLatencyTableOption);
+
+	QCommandLineOption noSnapshotOption("no-snapshot", "Do not restore or save the snapshot of the booted OS");
+	parser.addOption(noSnapshotOption);
+
+	QCommandLineOption appOption("app", "Watch the application binary and start it again without rebooting when it changes", "path");
+	parser.addOption(appOption);
+
+	QCommandLineOption gdbPortOption("gdb-port", "Start the GDB server on the given local TCP port", "port");
+	parser.addOption(gdbPortOption);
+
+	QCommandLineOption rs232Option("rs232", "Bridge the RS232 to a host pseudo-terminal or a local socket path", "pty|path");
+	parser.addOption(rs232Option);
+
+	QCommandLineOption machinesOption("machines", "Run the given number of machines connected by null-modem links, additional machines run without windows", "count");
+	parser.addOption(machinesOption);
+
+	QCommandLineOption linkBaudOption("link-baud", "Speed of the null-modem links in bauds, 0 is unlimited (default 1200)", "baud");
+	parser.addOption(linkBaudOption);
+
+	QCommandLineOption inputScriptOption("input-script", "Type the keyboard and RS232 input from the script file at exact emulated times", "path");
+	parser.addOption(inputScriptOption);
+
+	QCommandLineOption mapOption("map", "Read symbols from the map file written by the assembler to jump in the RAM view, the option can be repeated", "path");
+	parser.addOption(mapOption);
+
+	QCommandLineOption lcdFPSOption("lcd-fps", "Present the LCD at most the given number of times per second, 0 presents every refresh", "fps");
+	parser.addOption(lcdFPSOption);
+
+	QCommandLineOption speakerBandLimitOption("speaker-band-limit", "Smooth the edges of the square wave to limit aliasing of high notes");
+	parser.addOption(speakerBandLimitOption);
+
+	QCommandLineOption audioOption("audio", "Audio sink: device plays the sound, null only advances notes in the emulated time", "device|null");
+	parser.addOption(audioOption);
+
+	QCommandLineOption audioWavOption("audio-wav", "Write the sound played by the speaker to the WAV file", "path");
+	parser.addOption(audioWavOption);
+
+	QCommandLineOption rtcOption("rtc", "RTC time source: emulated counts seconds of the emulated time, wall follows the host clock", "emulated|wall");
+	parser.addOption(rtcOption);
+
+	QCommandLineOption rtcEpochOption("rtc-epoch", "Date and time of the emulated RTC after a reset (default 2000-01-01T00:00:00)", "yyyy-MM-ddThh:mm:ss");
+	parser.addOption(rtcEpochOption);
+
+	QCommandLineOption urom0Option("urom0", "Load the first uROM", "path");
+	parser.addOption(urom0Option);
+
+	QCommandLineOption urom1Option("urom1", "Load the second uROM", "path");
+	parser.addOption(urom1Option);
+
+	QCommandLineOption biosOption("bios", "Load the BIOS", "path");
+	parser.addOption(biosOption);
+
+	QCommandLineOption fsOption("fs", "Load the file system directory", "path");
+	parser.addOption(fsOption);
+
+	QCommandLineOption headlessOption("headless", "Run without the window, all files must be given on the command line");
+	parser.addOption(headlessOption);
+
+	QCommandLineOption exitAfterOption("exit-after", "Quit after the given emulated time", "ms");
+	parser.addOption(exitAfterOption);
+
+	QCommandLineOption lcdTextOption("lcd-text", "Write the LCD content as text to the file at the end, \"-\" is the standard output", "path");
+	parser.addOption(lcdTextOption);
+
+	QCommandLineOption lcdTextEveryFrameOption("lcd-text-every-frame", "Write the LCD text after every presented frame");
+	parser.addOption(lcdTextEveryFrameOption);
+
+	QCommandLineOption lcdRecordOption("lcd-record", "Record presented LCD frames as PNG files to the directory", "path");
+	parser.addOption(lcdRecordOption);
+
 	parser.process(app);
 
 	QFontDatabase::addApplicationFont("fonts/DejaVuSansMono-Bold.ttf");
@@ -43,8 +145,153 @@ int main(int argc, char *argv[])
 
 	QApplication::setFont(font, "QWidget");
 
+	bool headless = parser.isSet(headlessOption);
+
 	Emu emu;
-	emu.show();
+	emu.setHeadless(headless);
+	emu.setIOLatency(parser.isSet(ioLatencyOption));
+	emu.setSnapshotEnabled(!parser.isSet(noSnapshotOption));
+	emu.setAppPath(parser.value(appOption));
+	emu.setSpeakerBandLimited(parser.isSet(speakerBandLimitOption));
+
+	if(parser.isSet(audioOption) && (parser.value(audioOption) != "device") && (parser.value(audioOption) != "null"))
+	{
+		qCritical("Error: Bad value of the --audio option, use device or null");
+		return(1);
+	}
+
+	emu.setAudioDeviceEnabled(parser.value(audioOption) != "null");
+
+	if(parser.isSet(ioLatencyTableOption))
+	{
+		if(!emu.setIOLatencyTable(parser.value(ioLatencyTableOption)))
+		{
+			return(1);
+		}
+	}
+
+	if(parser.isSet(audioWavOption))
+	{
+		if(!emu.setAudioWavPath(parser.value(audioWavOption)))
+		{
+			return(1);
+		}
+	}
+
+	if(parser.isSet(rtcOption) && (parser.value(rtcOption) != "emulated") && (parser.value(rtcOption) != "wall"))
+	{
+		qCritical("Error: Bad value of the --rtc option, use emulated or wall");
+		return(1);
+	}
+
+	if(!emu.setRTC((parser.value(rtcOption) == "wall"), parser.value(rtcEpochOption)))
+	{
+		return(1);
+	}
+
+	if(parser.isSet(lcdFPSOption))
+	{
+		long long fps;
+
+		if(!parseNumber(parser, lcdFPSOption, 0, 1000, fps))
+		{
+			return(1);
+		}
+
+		emu.setLCDFPS(static_cast<int>(fps));
+	}
+
+	if(parser.isSet(exitAfterOption))
+	{
+		long long ms;
+
+		if(!parseNumber(parser, exitAfterOption, 1, 4294967295LL, ms))
+		{
+			return(1);
+		}
+
+		emu.setExitTime(static_cast<unsigned int>(ms));
+	}
+
+	if(parser.isSet(lcdTextOption) || parser.isSet(lcdRecordOption))
+	{
+		if(!emu.setLCDCapture(parser.value(lcdTextOption), parser.isSet(lcdTextEveryFrameOption), parser.value(lcdRecordOption)))
+		{
+			return(1);
+		}
+	}
+
+	if(parser.isSet(urom0Option) || parser.isSet(urom1Option) || parser.isSet(biosOption) || parser.isSet(fsOption) || headless)
+	{
+		if(!emu.loadFiles(parser.value(urom0Option), parser.value(urom1Option), parser.value(biosOption), parser.value(fsOption)))
+		{
+			return(1);
+		}
+	}
+
+	for(const QString &path : parser.values(mapOption))
+	{
+		if(!emu.addMapFile(path))
+		{
+			return(1);
+		}
+	}
+
+	if(parser.isSet(gdbPortOption))
+	{
+		long long port;
+
+		if((!parseNumber(parser, gdbPortOption, 1, 65535, port)) || (!emu.setGDBPort(static_cast<quint16>(port))))
+		{
+			return(1);
+		}
+	}
+
+	if(parser.isSet(rs232Option))
+	{
+		if(!emu.setRS232Bridge(parser.value(rs232Option)))
+		{
+			return(1);
+		}
+	}
+
+	if(parser.isSet(inputScriptOption))
+	{
+		if(!emu.setInputScript(parser.value(inputScriptOption)))
+		{
+			return(1);
+		}
+	}
+
+	if(parser.isSet(machinesOption))
+	{
+		long long machines;
+		long long baud = 1200;
+
+		if(!parseNumber(parser, machinesOption, 2, Network::MAX_MACHINES, machines))
+		{
+			return(1);
+		}
+
+		if(parser.isSet(linkBaudOption) && (!parseNumber(parser, linkBaudOption, 0, 1000000, baud)))
+		{
+			return(1);
+		}
+
+		if(!emu.setNetwork(static_cast<int>(machines), static_cast<int>(baud)))
+		{
+			return(1);
+		}
+	}
+
+	if(headless)
+	{
+		emu.start();
+	}
+	else
+	{
+		emu.show();
+	}
 
 	return(QApplication::exec());
 }
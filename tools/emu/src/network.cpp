@@ -0,0 +1,130 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "network.h"
+
+/**
+ * Constructor for the network class
+ *
+ * @param cpu CPU of the first machine
+ * @param io IO of the first machine
+ * @param parent Parent object
+ */
+Network::Network(CPU *cpu, IO *io, QObject *parent) : QObject(parent)
+{
+	this->cpu = cpu;
+	this->io = io;
+}
+
+//! Destructor for the network class. It stops all additional machines and prints the summary of the links.
+Network::~Network()
+{
+	this->stop();
+
+	QObject::disconnect(this);
+}
+
+/**
+ * Create the additional machines and the links and start the emulation of the additional machines.
+ * They use the same uROMs, BIOS and file system directory as the first machine, so it must be loaded.
+ *
+ * @param machines Quantity of all machines including the first one
+ * @param baud Speed of the links in bauds, 0 delivers bytes without a limit
+ * @param fsPath Path to the file system directory
+ *
+ * @return Status of starting the network, false when the quantity of machines is not supported
+ */
+bool Network::start(int machines, int baud, const QString &fsPath)
+{
+	this->stop();
+
+	if((machines < 2) || (machines > MAX_MACHINES) || (baud < 0))
+	{
+		return(false);
+	}
+
+	this->nullModem.reset(new NullModem(this->cpu, this->io, baud));
+
+	for(int i = 1; i < machines; i++)
+	{
+		this->nodes.append(new NetworkNode(this->cpu->getUrom0(), this->cpu->getUrom1(), this->cpu->getBios(), fsPath, this->io->getLatency(), baud));
+	}
+
+	// Every ordered pair of machines has its own ring, so each ring has one producer and one consumer
+	for(int from = 0; from < machines; from++)
+	{
+		for(int to = (from + 1); to < machines; to++)
+		{
+			QSharedPointer<ByteRing> forward(new ByteRing());
+			QSharedPointer<ByteRing> backward(new ByteRing());
+
+			if(from == 0)
+			{
+				this->nullModem->addLink(backward, forward);
+			}
+			else
+			{
+				this->nodes.at(from - 1)->addLink(backward, forward);
+			}
+
+			this->nodes.at(to - 1)->addLink(forward, backward);
+		}
+	}
+
+	for(NetworkNode *node : this->nodes)
+	{
+		QThread *thread = new QThread();
+
+		node->moveToThread(thread);
+
+		QObject::connect(thread, SIGNAL(started()), node, SLOT(startSlot()));
+
+		this->threads.append(thread);
+
+		thread->start();
+	}
+
+	return(true);
+}
+
+//! Stop all additional machines, wait for their threads and print the summary of the links
+void Network::stop()
+{
+	if(this->nullModem.isNull())
+	{
+		return;
+	}
+
+	for(int i = 0; i < this->nodes.size(); i++)
+	{
+		QMetaObject::invokeMethod(this->nodes.at(i), "stopSlot", Qt::BlockingQueuedConnection);
+
+		this->threads.at(i)->quit();
+		this->threads.at(i)->wait();
+	}
+
+	qInfo("Network machine 0: sent %llu, received %llu, dropped %llu bytes", this->nullModem->getSent(), this->nullModem->getReceived(), this->nullModem->getDropped());
+
+	for(int i = 0; i < this->nodes.size(); i++)
+	{
+		const NetworkNode *node = this->nodes.at(i);
+
+		qInfo("Network machine %d: sent %llu, received %llu, dropped %llu bytes, %llu ms emulated", (i + 1), node->getSent(), node->getReceived(), node->getDropped(), (node->getTicks() / (CPU::FREQUENCY / 1000)));
+	}
+
+	qDeleteAll(this->nodes);
+	qDeleteAll(this->threads);
+
+	this->nodes.clear();
+	this->threads.clear();
+
+	this->nullModem.reset();
+}
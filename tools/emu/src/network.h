@@ -0,0 +1,58 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef NETWORK_H
+#define NETWORK_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QThread>
+#include <QSharedPointer>
+#include <QScopedPointer>
+
+#include "bytering.h"
+#include "cpu.h"
+#include "io.h"
+#include "nullmodem.h"
+#include "networknode.h"
+
+//! This class contains a network of machines connected by null-modem links. The first machine is the one of the window, every additional machine runs on its own thread.
+//! Every machine receives the bytes sent by all other machines, so two machines are connected like by a single null-modem cable.
+class Network : public QObject
+{
+	Q_OBJECT
+
+	public:
+		static const int MAX_MACHINES = 16; //!< Maximum quantity of machines in the network
+
+		Network(CPU *cpu, IO *io, QObject *parent = nullptr);
+		~Network() override;
+
+		Network(const Network &) = delete;
+		Network &operator=(const Network &) = delete;
+		Network(Network &&) = delete;
+		Network &operator=(Network &&) = delete;
+
+		bool start(int machines, int baud, const QString &fsPath);
+
+	private:
+		CPU *cpu; //!< CPU of the first machine
+		IO *io; //!< IO of the first machine
+
+		QScopedPointer<NullModem> nullModem; //!< RS232 side of the first machine in the network
+		QVector<NetworkNode *> nodes; //!< Additional machines
+		QVector<QThread *> threads; //!< Threads of the additional machines
+
+		void stop();
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "networknode.h"
+
+/**
+ * Constructor for the network node class
+ *
+ * @param urom0 First uROM of the machine
+ * @param urom1 Second uROM of the machine
+ * @param bios BIOS of the machine
+ * @param fsPath Path to the file system directory
+ * @param latency Processing time model of the IO board
+ * @param baud Speed of the links in bauds, 0 delivers bytes without a limit
+ * @param parent Parent object
+ */
+NetworkNode::NetworkNode(const CPU::UROM &urom0, const CPU::UROM &urom1, const CPU::BIOS &bios, const QString &fsPath, const IO::Latency &latency, int baud, QObject *parent) : QObject(parent)
+{
+	this->urom0 = urom0;
+	this->urom1 = urom1;
+	this->bios = bios;
+	this->fsPath = fsPath;
+	this->latency = latency;
+	this->baud = baud;
+
+	this->ticks = 0;
+	this->sent = 0;
+	this->received = 0;
+	this->dropped = 0;
+}
+
+//! Destructor for the network node class
+NetworkNode::~NetworkNode()
+{
+	this->stopSlot();
+
+	QObject::disconnect(this);
+}
+
+/**
+ * Add a link to another machine. It must be called before the node is started.
+ *
+ * @param input Ring read by this machine
+ * @param output Ring written by this machine
+ */
+void NetworkNode::addLink(const QSharedPointer<ByteRing> &input, const QSharedPointer<ByteRing> &output)
+{
+	this->inputs.append(input);
+	this->outputs.append(output);
+}
+
+/**
+ * Get the CPU clock ticks of the stopped machine
+ *
+ * @return CPU clock ticks
+ */
+unsigned long long NetworkNode::getTicks() const
+{
+	return(this->ticks);
+}
+
+/**
+ * Get the counter of sent bytes of the stopped machine
+ *
+ * @return Quantity of bytes
+ */
+unsigned long long NetworkNode::getSent() const
+{
+	return(this->sent);
+}
+
+/**
+ * Get the counter of received bytes of the stopped machine
+ *
+ * @return Quantity of bytes
+ */
+unsigned long long NetworkNode::getReceived() const
+{
+	return(this->received);
+}
+
+/**
+ * Get the counter of dropped bytes of the stopped machine
+ *
+ * @return Quantity of bytes
+ */
+unsigned long long NetworkNode::getDropped() const
+{
+	return(this->dropped);
+}
+
+//! Create the machine on the node thread and start the emulation. The sound is never played.
+void NetworkNode::startSlot()
+{
+	this->cpu.reset(new CPU());
+	this->io.reset(new IO());
+
+	this->io->setScheduler(&this->cpu->getScheduler());
+	this->io->setLatency(this->latency);
+	this->io->speakerSetDeviceEnabled(false);
+	this->io->fsSetPath(this->fsPath);
+
+	this->cpu->setUrom0(this->urom0);
+	this->cpu->setUrom1(this->urom1);
+	this->cpu->setBios(this->bios);
+
+	QObject::connect(this->cpu.data(), SIGNAL(counterSignal(unsigned long long, unsigned long long)), this->io.data(), SLOT(counterSlot(unsigned long long, unsigned long long)));
+	QObject::connect(this->cpu.data(), SIGNAL(outSignal(unsigned char)), this->io.data(), SLOT(outSlot(unsigned char)));
+	QObject::connect(this->io.data(), SIGNAL(inSignal(unsigned char)), this->cpu.data(), SLOT(inSlot(unsigned char)));
+
+	this->nullModem.reset(new NullModem(this->cpu.data(), this->io.data(), this->baud));
+
+	for(int i = 0; i < this->inputs.size(); i++)
+	{
+		this->nullModem->addLink(this->inputs.at(i), this->outputs.at(i));
+	}
+
+	this->cpu->run();
+}
+
+//! Stop the emulation and remove the machine. Counters are kept for the summary. It must be called on the node thread.
+void NetworkNode::stopSlot()
+{
+	if(this->cpu.isNull())
+	{
+		return;
+	}
+
+	this->cpu->pause();
+
+	this->ticks = this->cpu->getTicks();
+	this->sent = this->nullModem->getSent();
+	this->received = this->nullModem->getReceived();
+	this->dropped = this->nullModem->getDropped();
+
+	this->nullModem.reset();
+
+	QObject::disconnect(this->io.data());
+	QObject::disconnect(this->cpu.data());
+
+	this->io.reset();
+	this->cpu.reset();
+}
@@ -0,0 +1,72 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef NETWORKNODE_H
+#define NETWORKNODE_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QSharedPointer>
+#include <QScopedPointer>
+
+#include "bytering.h"
+#include "cpu.h"
+#include "io.h"
+#include "nullmodem.h"
+
+//! This class contains an additional machine of the null-modem network without the window. The CPU and the IO are created and run on the thread of the node.
+class NetworkNode : public QObject
+{
+	Q_OBJECT
+
+	public:
+		NetworkNode(const CPU::UROM &urom0, const CPU::UROM &urom1, const CPU::BIOS &bios, const QString &fsPath, const IO::Latency &latency, int baud, QObject *parent = nullptr);
+		~NetworkNode() override;
+
+		NetworkNode(const NetworkNode &) = delete;
+		NetworkNode &operator=(const NetworkNode &) = delete;
+		NetworkNode(NetworkNode &&) = delete;
+		NetworkNode &operator=(NetworkNode &&) = delete;
+
+		void addLink(const QSharedPointer<ByteRing> &input, const QSharedPointer<ByteRing> &output);
+
+		unsigned long long getTicks() const;
+		unsigned long long getSent() const;
+		unsigned long long getReceived() const;
+		unsigned long long getDropped() const;
+
+	private:
+		CPU::UROM urom0; //!< First uROM of the machine
+		CPU::UROM urom1; //!< Second uROM of the machine
+		CPU::BIOS bios; //!< BIOS of the machine
+		QString fsPath; //!< Path to the file system directory
+		IO::Latency latency; //!< Processing time model of the IO board
+		int baud; //!< Speed of the links in bauds
+
+		QVector<QSharedPointer<ByteRing>> inputs; //!< Rings with bytes sent by other machines
+		QVector<QSharedPointer<ByteRing>> outputs; //!< Rings with bytes for other machines
+
+		QScopedPointer<CPU> cpu; //!< CPU of the machine, created on the node thread
+		QScopedPointer<IO> io; //!< IO of the machine, created on the node thread
+		QScopedPointer<NullModem> nullModem; //!< RS232 side of the machine in the network
+
+		unsigned long long ticks; //!< CPU clock ticks when the machine was stopped
+		unsigned long long sent; //!< Counter of sent bytes when the machine was stopped
+		unsigned long long received; //!< Counter of received bytes when the machine was stopped
+		unsigned long long dropped; //!< Counter of dropped bytes when the machine was stopped
+
+	public slots:
+		void startSlot();
+		void stopSlot();
+};
+
+#endif
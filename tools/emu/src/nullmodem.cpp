@@ -0,0 +1,165 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "nullmodem.h"
+
+/**
+ * Constructor for the null-modem class
+ *
+ * @param cpu CPU of the machine
+ * @param io IO of the machine
+ * @param baud Speed of the line in bauds, 0 delivers bytes without a limit
+ * @param parent Parent object
+ */
+NullModem::NullModem(CPU *cpu, IO *io, int baud, QObject *parent) : QObject(parent)
+{
+	this->cpu = cpu;
+	this->io = io;
+
+	this->nextInput = 0;
+
+	this->ticksPerByte = ((baud > 0) ? ((static_cast<unsigned long long>(CPU::FREQUENCY) * BITS_PER_BYTE) / static_cast<unsigned long long>(baud)) : 0);
+	this->lastTicks = this->cpu->getTicks();
+	this->credit = 0;
+
+	this->sent = 0;
+	this->received = 0;
+	this->dropped = 0;
+
+	QObject::connect(this->io, SIGNAL(updateRS232TxSignal(QByteArray)), this, SLOT(transmitSlot(QByteArray)));
+	QObject::connect(this->cpu, SIGNAL(updateSignal()), this, SLOT(receiveSlot()));
+}
+
+//! Destructor for the null-modem class
+NullModem::~NullModem()
+{
+	QObject::disconnect(this);
+}
+
+/**
+ * Add a link to another machine. It must be called before the machine thread starts.
+ *
+ * @param input Ring read by this machine
+ * @param output Ring written by this machine
+ */
+void NullModem::addLink(const QSharedPointer<ByteRing> &input, const QSharedPointer<ByteRing> &output)
+{
+	this->inputs.append(input);
+	this->outputs.append(output);
+}
+
+/**
+ * Get the counter of bytes sent to all links
+ *
+ * @return Quantity of bytes
+ */
+unsigned long long NullModem::getSent() const
+{
+	return(this->sent);
+}
+
+/**
+ * Get the counter of bytes received from all links
+ *
+ * @return Quantity of bytes
+ */
+unsigned long long NullModem::getReceived() const
+{
+	return(this->received);
+}
+
+/**
+ * Get the counter of bytes lost because a link was full
+ *
+ * @return Quantity of bytes
+ */
+unsigned long long NullModem::getDropped() const
+{
+	return(this->dropped);
+}
+
+/**
+ * Send the transmitted bytes to all links. Zero ends a line, so it is sent as a line feed like on a real cable.
+ *
+ * @param data Transmitted bytes
+ */
+void NullModem::transmitSlot(const QByteArray &data)
+{
+	QByteArray out = data;
+
+	out.replace('\0', '\n');
+
+	for(const QSharedPointer<ByteRing> &output : this->outputs)
+	{
+		const int written = output->write(out.constData(), out.size());
+
+		this->sent += static_cast<unsigned long long>(written);
+		this->dropped += static_cast<unsigned long long>(out.size() - written);
+	}
+}
+
+/**
+ * Deliver bytes from the links to the receive ring of the RS232. It is called after every emulation step.
+ * The quantity of bytes follows the emulated time and the speed of the line, and never exceeds the free space of the receive ring, so the rest waits in the links.
+ */
+void NullModem::receiveSlot()
+{
+	if(this->inputs.isEmpty())
+	{
+		return;
+	}
+
+	const unsigned long long ticks = this->cpu->getTicks();
+
+	// The CPU clock starts from zero after a reset
+	this->credit += ((ticks >= this->lastTicks) ? (ticks - this->lastTicks) : ticks);
+	this->lastTicks = ticks;
+
+	int budget = this->io->rs232GetReceiveFree();
+
+	if(this->ticksPerByte > 0)
+	{
+		budget = static_cast<int>(qMin(static_cast<unsigned long long>(budget), (this->credit / this->ticksPerByte)));
+	}
+
+	QByteArray data(budget, 0);
+	int count = 0;
+
+	for(int i = 0; (i < this->inputs.size()) && (count < budget); i++)
+	{
+		count += this->inputs.at((this->nextInput + i) % this->inputs.size())->read((data.data() + count), (budget - count));
+	}
+
+	this->nextInput = ((this->nextInput + 1) % this->inputs.size());
+
+	if(count > 0)
+	{
+		data.truncate(count);
+
+		this->io->rs232ReceiveRaw(data);
+		this->received += static_cast<unsigned long long>(count);
+	}
+
+	if(this->ticksPerByte > 0)
+	{
+		this->credit -= (static_cast<unsigned long long>(count) * this->ticksPerByte);
+
+		// An idle line does not save time for a later burst
+		if(count < budget)
+		{
+			this->credit = qMin(this->credit, this->ticksPerByte);
+		}
+	}
+	else
+	{
+		this->credit = 0;
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef NULLMODEM_H
+#define NULLMODEM_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "bytering.h"
+#include "cpu.h"
+#include "io.h"
+
+//! This class contains the RS232 side of one machine in a null-modem network. It lives on the thread of its machine and exchanges bytes with other machines through lock-free rings.
+class NullModem : public QObject
+{
+	Q_OBJECT
+
+	public:
+		static const int BITS_PER_BYTE = 10; //!< Bits sent on the line for every byte: start bit, 8 data bits and stop bit
+
+		NullModem(CPU *cpu, IO *io, int baud, QObject *parent = nullptr);
+		~NullModem() override;
+
+		NullModem(const NullModem &) = delete;
+		NullModem &operator=(const NullModem &) = delete;
+		NullModem(NullModem &&) = delete;
+		NullModem &operator=(NullModem &&) = delete;
+
+		void addLink(const QSharedPointer<ByteRing> &input, const QSharedPointer<ByteRing> &output);
+
+		unsigned long long getSent() const;
+		unsigned long long getReceived() const;
+		unsigned long long getDropped() const;
+
+	private:
+		CPU *cpu; //!< CPU of the machine, its clock paces the received bytes
+		IO *io; //!< IO of the machine
+
+		QVector<QSharedPointer<ByteRing>> inputs; //!< Rings with bytes sent by other machines
+		QVector<QSharedPointer<ByteRing>> outputs; //!< Rings with bytes for other machines
+		int nextInput; //!< Input read first in the next delivery, so all senders are served in turn
+
+		unsigned long long ticksPerByte; //!< CPU clock ticks needed to receive one byte, 0 delivers bytes without a limit
+		unsigned long long lastTicks; //!< CPU clock ticks at the previous delivery
+		unsigned long long credit; //!< CPU clock ticks not used yet for receiving bytes
+
+		unsigned long long sent; //!< Counter of bytes sent to all links
+		unsigned long long received; //!< Counter of bytes received from all links
+		unsigned long long dropped; //!< Counter of bytes lost because a link was full
+
+	private slots:
+		void transmitSlot(const QByteArray &data);
+		void receiveSlot();
+};
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "rammodel.h"
+
+/**
+ * Constructor for the RAM model class
+ *
+ * @param cpu CPU with the shown memory
+ * @param parent Parent object
+ */
+RAMModel::RAMModel(const CPU *cpu, QObject *parent) : QAbstractTableModel(parent)
+{
+	this->cpu = cpu;
+	this->enabled = false;
+
+	this->previous = QVector<unsigned char>(CPU::MEMORY_SIZE);
+	this->changed = QBitArray(CPU::MEMORY_SIZE);
+}
+
+/**
+ * Get quantity of rows
+ *
+ * @param parent Parent index
+ *
+ * @return Quantity of rows, 0 for any valid parent
+ */
+int RAMModel::rowCount(const QModelIndex &parent) const
+{
+	return(parent.isValid() ? 0 : ROWS);
+}
+
+/**
+ * Get quantity of columns
+ *
+ * @param parent Parent index
+ *
+ * @return Quantity of columns, 0 for any valid parent
+ */
+int RAMModel::columnCount(const QModelIndex &parent) const
+{
+	return(parent.isValid() ? 0 : COLUMNS);
+}
+
+/**
+ * Get data of a byte. The value is read from the memory at the moment of drawing.
+ *
+ * @param index Index of the byte
+ * @param role Data role
+ *
+ * @return Hex value, alignment or background of the byte
+ */
+QVariant RAMModel::data(const QModelIndex &index, int role) const
+{
+	if((!this->enabled) || (!index.isValid()))
+	{
+		return(QVariant());
+	}
+
+	const int address = ((index.row() * COLUMNS) + index.column());
+
+	switch(role)
+	{
+		case Qt::DisplayRole:
+			return(QString("%1").arg(this->read(address), 2, 16, QChar('0')));
+
+		case Qt::TextAlignmentRole:
+			return(Qt::AlignCenter);
+
+		case Qt::BackgroundRole:
+			if(this->changed.testBit(address))
+			{
+				return(this->changedColor);
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	return(QVariant());
+}
+
+/**
+ * Get header data. Rows show their address and columns show the low nibble of the address.
+ *
+ * @param section Number of the row or the column
+ * @param orientation Header orientation
+ * @param role Data role
+ *
+ * @return Header text
+ */
+QVariant RAMModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if(role != Qt::DisplayRole)
+	{
+		return(QVariant());
+	}
+
+	if(orientation == Qt::Vertical)
+	{
+		return(QString("%1").arg((section * COLUMNS), 4, 16, QChar('0')).toUpper());
+	}
+
+	return(QString("%1").arg(section, 1, 16).toUpper());
+}
+
+/**
+ * Set showing the memory. The content is taken as the base for the next changes, so nothing is highlighted after the start.
+ *
+ * @param enable Enable status
+ */
+void RAMModel::setEnabled(bool enable)
+{
+	if(this->enabled == enable)
+	{
+		return;
+	}
+
+	this->beginResetModel();
+
+	this->enabled = enable;
+	this->changed.fill(false);
+
+	if(this->enabled)
+	{
+		for(int i = 0; i < CPU::MEMORY_SIZE; i++)
+		{
+			this->previous[i] = this->read(i);
+		}
+	}
+
+	this->endResetModel();
+}
+
+/**
+ * Compare the given rows with the previous update and tell the view about changed bytes and bytes which are not highlighted anymore.
+ * Rows outside of the range are not read, so the cost follows the size of the view instead of the size of the memory.
+ *
+ * @param firstRow First visible row
+ * @param lastRow Last visible row
+ */
+void RAMModel::refresh(int firstRow, int lastRow)
+{
+	if(!this->enabled)
+	{
+		return;
+	}
+
+	firstRow = qBound(0, firstRow, (ROWS - 1));
+	lastRow = qBound(firstRow, lastRow, (ROWS - 1));
+
+	int dirtyFirst = -1;
+	int dirtyLast = -1;
+
+	for(int row = firstRow; row <= lastRow; row++)
+	{
+		for(int column = 0; column < COLUMNS; column++)
+		{
+			const int address = ((row * COLUMNS) + column);
+			const unsigned char value = this->read(address);
+			const bool isChanged = (value != this->previous.at(address));
+
+			if(isChanged || this->changed.testBit(address))
+			{
+				if(dirtyFirst < 0)
+				{
+					dirtyFirst = row;
+				}
+
+				dirtyLast = row;
+			}
+
+			this->previous[address] = value;
+			this->changed.setBit(address, isChanged);
+		}
+	}
+
+	if(dirtyFirst >= 0)
+	{
+		emit dataChanged(this->index(dirtyFirst, 0), this->index(dirtyLast, (COLUMNS - 1)), { Qt::DisplayRole, Qt::BackgroundRole });
+	}
+}
+
+/**
+ * Read a byte of the memory. Addresses below the BIOS size are read from the BIOS.
+ *
+ * @param address Address of the byte
+ *
+ * @return Value of the byte
+ */
+unsigned char RAMModel::read(int address) const
+{
+	if(address < CPU::BIOS_SIZE)
+	{
+		return(this->cpu->getBios().data.at(address));
+	}
+
+	return(this->cpu->getRam().data.at(address));
+}
@@ -0,0 +1,60 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef RAMMODEL_H
+#define RAMMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVariant>
+#include <QVector>
+#include <QBitArray>
+#include <QColor>
+
+#include "cpu.h"
+
+//! This class contains a table model of the whole memory used by the RAM view. Only rows visible in the view are compared with the previous update.
+class RAMModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+	public:
+		static const int COLUMNS = 16; //!< Quantity of bytes in a row
+		static const int ROWS = (CPU::MEMORY_SIZE / COLUMNS); //!< Quantity of rows
+
+		RAMModel(const CPU *cpu, QObject *parent = nullptr);
+
+		RAMModel(const RAMModel &) = delete;
+		RAMModel &operator=(const RAMModel &) = delete;
+		RAMModel(RAMModel &&) = delete;
+		RAMModel &operator=(RAMModel &&) = delete;
+
+		int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+		int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+		QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+		QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+		void setEnabled(bool enable);
+		void refresh(int firstRow, int lastRow);
+
+	private:
+		const CPU *cpu; //!< CPU with the shown memory
+		bool enabled; //!< Status of showing the memory, it is false when the emulation is not started
+
+		QVector<unsigned char> previous; //!< Memory content at the previous update of every row
+		QBitArray changed; //!< Bytes changed at the previous update of their row
+
+		const QColor changedColor = QColor(255, 210, 120); //!< Background of changed bytes
+
+		unsigned char read(int address) const;
+};
+
+#endif
@@ -18,17 +18,109 @@
  */
 RS232::RS232(QObject *parent) : QObject(parent)
 {
+	this->flushTimer.setSingleShot(true);
+	this->flushTimer.setInterval(0);
+
+	QObject::connect(&this->flushTimer, SIGNAL(timeout()), this, SLOT(flushSlot()));
+
 	this->reset();
 }
 
 //! Reset the RS232 buffers
 void RS232::reset()
 {
-	this->rxBuffer.clear();
+	this->rxRing.head = 0;
+	this->rxRing.count = 0;
+	this->txRing.head = 0;
+	this->txRing.count = 0;
+
+	this->rxTap.clear();
+	this->rxRawCR = false;
+	this->rxFull = false;
+
+	this->flushTimer.stop();
+}
+
+/**
+ * Add a byte at the end of the ring
+ *
+ * @param ring Ring
+ * @param c Byte to add
+ *
+ * @return Status of adding the byte, false when the ring is full
+ */
+bool RS232::push(RS232::Ring &ring, unsigned char c)
+{
+	if(ring.count >= RING_SIZE)
+	{
+		return(false);
+	}
+
+	ring.data[(ring.head + ring.count) % RING_SIZE] = static_cast<char>(c);
+	ring.count++;
+
+	return(true);
+}
+
+/**
+ * Remove the first byte of the ring
+ *
+ * @param ring Ring
+ *
+ * @return Removed byte, 0 when the ring is empty
+ */
+unsigned char RS232::pop(RS232::Ring &ring)
+{
+	if(ring.count == 0)
+	{
+		return(0);
+	}
+
+	unsigned char c = static_cast<unsigned char>(ring.data.at(ring.head));
+
+	ring.head = ((ring.head + 1) % RING_SIZE);
+	ring.count--;
+
+	return(c);
+}
+
+/**
+ * Remove all bytes of the ring
+ *
+ * @param ring Ring
+ *
+ * @return Removed bytes in order
+ */
+QByteArray RS232::take(RS232::Ring &ring)
+{
+	QByteArray data;
+	const int first = qMin(ring.count, (RING_SIZE - ring.head));
+
+	data.reserve(ring.count);
+	data.append(ring.data.constData() + ring.head, first);
+	data.append(ring.data.constData(), (ring.count - first));
+
+	ring.head = 0;
+	ring.count = 0;
+
+	return(data);
+}
+
+/**
+ * Add a byte to the receive ring and to the view
+ *
+ * @param c Received byte
+ */
+void RS232::addReceived(unsigned char c)
+{
+	if(push(this->rxRing, c))
+	{
+		this->rxTap.append(static_cast<char>(c));
+	}
 }
 
 /**
- * Receive function used to emulate input
+ * Receive function used to emulate input from the view. A line ends with zero.
  *
  * @param text Received text
  */
@@ -42,35 +134,95 @@ void RS232::rx(const QString &text)
 
 		if((c >= MIN_CODE) && (c <= MAX_CODE))
 		{
-			this->rxBuffer.append(c);
+			this->addReceived(c);
 
 			charAdded++;
-
-			emit updateRxSignal(c);
 		}
 	}
 
 	if(charAdded > 0)
 	{
-		this->rxBuffer.append(0x00);
+		this->addReceived(0x00);
+	}
 
-		emit updateRxSignal(0x00);
+	if(this->rxRing.count > 0)
+	{
+		emit dataReadySignal(true);
 	}
 
-	if(this->rxBuffer.length() > 0)
+	this->flushTimer.start();
+}
+
+/**
+ * Receive function used by the bridge. Carriage return, line feed and their pair end a line with zero, other control chars are skipped.
+ * Every input byte adds at most one byte to the receive ring, so the bridge never gives more bytes than the free space.
+ *
+ * @param data Received bytes
+ *
+ * @return Quantity of used input bytes, the rest must be given again when the ring has space
+ */
+int RS232::rxRaw(const QByteArray &data)
+{
+	int used = 0;
+
+	for(; used < data.size(); used++)
+	{
+		if(this->rxRing.count >= RING_SIZE)
+		{
+			this->rxFull = true;
+			break;
+		}
+
+		unsigned char c = static_cast<unsigned char>(data.at(used));
+
+		if((c == '\n') && this->rxRawCR)
+		{
+			this->rxRawCR = false;
+			continue;
+		}
+
+		this->rxRawCR = (c == '\r');
+
+		if((c == '\r') || (c == '\n'))
+		{
+			this->addReceived(0x00);
+		}
+		else if((c >= MIN_CODE) && (c <= MAX_CODE))
+		{
+			this->addReceived(c);
+		}
+	}
+
+	if(this->rxRing.count >= RING_SIZE)
+	{
+		this->rxFull = true;
+	}
+
+	if(this->rxRing.count > 0)
 	{
 		emit dataReadySignal(true);
 	}
+
+	this->flushTimer.start();
+
+	return(used);
 }
 
 /**
- * Send char
+ * Send char. Chars are collected in the transmit ring and flushed together.
  *
  * @param c Char to send
  */
 void RS232::send(unsigned char c)
 {
-	emit updateTxSignal(c & SEND_MASK);
+	if(!push(this->txRing, (c & SEND_MASK)))
+	{
+		this->flushSlot();
+
+		push(this->txRing, (c & SEND_MASK));
+	}
+
+	this->flushTimer.start();
 }
 
 /**
@@ -80,9 +232,18 @@ void RS232::send(unsigned char c)
  */
 unsigned char RS232::receive()
 {
-	if(this->rxBuffer.length() > 0)
+	if(this->rxRing.count > 0)
 	{
-		return(this->rxBuffer.takeFirst());
+		unsigned char c = pop(this->rxRing);
+
+		if(this->rxFull && (this->rxRing.count <= (RING_SIZE / 2)))
+		{
+			this->rxFull = false;
+
+			emit receiveFreeSignal();
+		}
+
+		return(c);
 	}
 
 	emit dataReadySignal(false);
@@ -99,3 +260,74 @@ unsigned char RS232::getSendBufferFree()
 {
 	return(BUFFER_TX_SIZE);
 }
+
+/**
+ * Get free space size in the receive ring. It is the quantity of bytes the bridge can give at once.
+ *
+ * @return Free space size in the receive ring
+ */
+int RS232::getReceiveRingFree() const
+{
+	return(RING_SIZE - this->rxRing.count);
+}
+
+//! Send the collected transmitted bytes to the bridge and the view, and the received bytes to the view
+void RS232::flushSlot()
+{
+	if(this->txRing.count > 0)
+	{
+		emit updateTxSignal(take(this->txRing));
+	}
+
+	if(!this->rxTap.isEmpty())
+	{
+		emit updateRxSignal(this->rxTap);
+
+		this->rxTap.clear();
+	}
+}
+
+/**
+ * Save the receive ring and not flushed transmitted bytes to the state stream
+ *
+ * @param stream State stream
+ */
+void RS232::saveState(QDataStream &stream) const
+{
+	Ring rxRing = this->rxRing;
+	Ring txRing = this->txRing;
+
+	stream << take(rxRing) << take(txRing);
+}
+
+/**
+ * Load the receive ring and not flushed transmitted bytes from the state stream
+ *
+ * @param stream State stream
+ */
+void RS232::loadState(QDataStream &stream)
+{
+	QByteArray rxData;
+	QByteArray txData;
+
+	stream >> rxData >> txData;
+
+	this->reset();
+
+	for(char c : rxData)
+	{
+		push(this->rxRing, static_cast<unsigned char>(c));
+	}
+
+	for(char c : txData)
+	{
+		push(this->txRing, static_cast<unsigned char>(c));
+	}
+
+	if(this->txRing.count > 0)
+	{
+		this->flushTimer.start();
+	}
+
+	emit dataReadySignal(this->rxRing.count > 0);
+}
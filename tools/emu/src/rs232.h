@@ -14,7 +14,9 @@
 
 #include <QObject>
 #include <QString>
-#include <QList>
+#include <QByteArray>
+#include <QTimer>
+#include <QDataStream>
 
 //! This class contains RS232 functions
 class RS232 : public QObject
@@ -25,6 +27,8 @@ class RS232 : public QObject
 		static const int BUFFER_RX_SIZE = 64; //!< Receive buffer size
 		static const int BUFFER_TX_SIZE = 64; //!< Transmit buffer size
 
+		static const int RING_SIZE = 4096; //!< Size of the host side rings in both directions, the receive ring is the flow control window of the bridge
+
 		static const int SEND_MASK = 0x7f; //!< Mask to make a basic ASCII char set
 
 		static const int MAX_CODE = 0x7f; //!< Maximum allowed ASCII char
@@ -32,23 +36,59 @@ class RS232 : public QObject
 
 		RS232(QObject *parent = nullptr);
 
+		RS232(const RS232 &) = delete;
+		RS232 &operator=(const RS232 &) = delete;
+		RS232(RS232 &&) = delete;
+		RS232 &operator=(RS232 &&) = delete;
+
 		void reset();
 
+		void saveState(QDataStream &stream) const;
+		void loadState(QDataStream &stream);
+
 		void rx(const QString &text);
+		int rxRaw(const QByteArray &data);
 
 		void send(unsigned char c);
 		unsigned char receive();
 
 		unsigned char getSendBufferFree();
+		int getReceiveRingFree() const;
 
 	private:
-		QList<unsigned char> rxBuffer; //!< Receive buffer
+		//! Bounded ring of bytes
+		struct Ring
+		{
+			QByteArray data = QByteArray(RING_SIZE, 0); //!< Bytes of the ring
+			int head = 0; //!< Position of the first byte
+			int count = 0; //!< Quantity of bytes in the ring
+		};
+
+		Ring rxRing; //!< Receive ring, bytes waiting for the CPU
+		Ring txRing; //!< Transmit ring, bytes sent by the CPU and waiting for the flush
+
+		QByteArray rxTap; //!< Received bytes waiting for the flush to the view
+		bool rxRawCR; //!< Status of the last raw received byte being a carriage return, the following line feed is skipped
+		bool rxFull; //!< Status of refusing bytes because of the full receive ring, the bridge is told when there is space again
+
+		QTimer flushTimer; //!< Timer used to flush both directions once per event loop turn instead of once per char
+
+		static bool push(RS232::Ring &ring, unsigned char c);
+		static unsigned char pop(RS232::Ring &ring);
+		static QByteArray take(RS232::Ring &ring);
+
+		void addReceived(unsigned char c);
 
 	signals:
-		void updateTxSignal(unsigned char c);
-		void updateRxSignal(unsigned char c);
+		void updateTxSignal(const QByteArray &data);
+		void updateRxSignal(const QByteArray &data);
+
+		void receiveFreeSignal();
 
 		void dataReadySignal(bool ready);
+
+	private slots:
+		void flushSlot();
 };
 
 #endif
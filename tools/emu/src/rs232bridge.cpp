@@ -0,0 +1,326 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "rs232bridge.h"
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <cerrno>
+#include <cstdlib>
+#endif
+
+/**
+ * Constructor for the RS232 bridge class
+ *
+ * @param io IO with the bridged RS232
+ * @param parent Parent object
+ */
+RS232Bridge::RS232Bridge(IO *io, QObject *parent) : QObject(parent)
+{
+	this->io = io;
+	this->ptyFd = -1;
+	this->ptySlaveFd = -1;
+
+	QObject::connect(&this->server, SIGNAL(newConnection()), this, SLOT(newConnectionSlot()));
+
+	QObject::connect(this->io, SIGNAL(updateRS232TxSignal(QByteArray)), this, SLOT(transmitSlot(QByteArray)));
+	QObject::connect(this->io, SIGNAL(rs232ReceiveFreeSignal()), this, SLOT(readSlot()));
+}
+
+//! Destructor for the RS232 bridge class
+RS232Bridge::~RS232Bridge()
+{
+	QObject::disconnect(this);
+
+	this->closePty();
+	this->server.close();
+}
+
+/**
+ * Start listening for the host program on a local socket. An old socket file with the same path is removed.
+ *
+ * @param path Path of the socket
+ *
+ * @return Status of starting the server
+ */
+bool RS232Bridge::listen(const QString &path)
+{
+	QLocalServer::removeServer(path);
+
+	if(!this->server.listen(path))
+	{
+		return(false);
+	}
+
+	this->path = this->server.fullServerName();
+
+	return(true);
+}
+
+/**
+ * Open a host pseudo-terminal. Its slave side path is returned by getPath().
+ *
+ * @return Status of opening the pseudo-terminal, it is always false on systems without pseudo-terminals
+ */
+bool RS232Bridge::openPty()
+{
+#ifdef Q_OS_UNIX
+	this->closePty();
+
+	int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+	if(fd < 0)
+	{
+		return(false);
+	}
+
+	if((grantpt(fd) != 0) || (unlockpt(fd) != 0) || (ptsname(fd) == nullptr))
+	{
+		::close(fd);
+		return(false);
+	}
+
+	this->path = QString::fromLocal8Bit(ptsname(fd));
+
+	// The slave side is kept open, so the master does not report a hang up while no host program uses it
+	int slaveFd = ::open(ptsname(fd), (O_RDWR | O_NOCTTY));
+
+	if(slaveFd < 0)
+	{
+		::close(fd);
+		return(false);
+	}
+
+	// Raw mode, so bytes are passed without the line discipline of the host
+	struct termios attr;
+
+	if(tcgetattr(slaveFd, &attr) == 0)
+	{
+		cfmakeraw(&attr);
+		tcsetattr(slaveFd, TCSANOW, &attr);
+	}
+
+	fcntl(fd, F_SETFL, (fcntl(fd, F_GETFL) | O_NONBLOCK));
+
+	this->ptyFd = fd;
+	this->ptySlaveFd = slaveFd;
+
+	this->ptyReadNotifier.reset(new QSocketNotifier(fd, QSocketNotifier::Read));
+	this->ptyWriteNotifier.reset(new QSocketNotifier(fd, QSocketNotifier::Write));
+	this->ptyWriteNotifier->setEnabled(false);
+
+	QObject::connect(this->ptyReadNotifier.data(), SIGNAL(activated(int)), this, SLOT(readSlot()));
+	QObject::connect(this->ptyWriteNotifier.data(), SIGNAL(activated(int)), this, SLOT(ptyWriteSlot()));
+
+	return(true);
+#else
+	return(false);
+#endif
+}
+
+/**
+ * Get the path of the socket or the slave side of the pseudo-terminal
+ *
+ * @return Path used by the host program
+ */
+QString RS232Bridge::getPath() const
+{
+	return(this->path);
+}
+
+//! Close the pseudo-terminal if it is open
+void RS232Bridge::closePty()
+{
+	this->ptyReadNotifier.reset();
+	this->ptyWriteNotifier.reset();
+	this->ptyPending.clear();
+
+#ifdef Q_OS_UNIX
+	if(this->ptyFd >= 0)
+	{
+		::close(this->ptyFd);
+	}
+
+	if(this->ptySlaveFd >= 0)
+	{
+		::close(this->ptySlaveFd);
+	}
+#endif
+
+	this->ptyFd = -1;
+	this->ptySlaveFd = -1;
+}
+
+//! Write the waiting transmitted bytes to the pseudo-terminal until it is full
+void RS232Bridge::writePty()
+{
+#ifdef Q_OS_UNIX
+	while(!this->ptyPending.isEmpty())
+	{
+		ssize_t written = ::write(this->ptyFd, this->ptyPending.constData(), static_cast<size_t>(this->ptyPending.size()));
+
+		if(written <= 0)
+		{
+			if((written < 0) && (errno == EINTR))
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		this->ptyPending.remove(0, static_cast<int>(written));
+	}
+#endif
+
+	if(this->ptyWriteNotifier)
+	{
+		this->ptyWriteNotifier->setEnabled(!this->ptyPending.isEmpty());
+	}
+}
+
+//! Process a new connection from the host program. Only one connection is served, the next one replaces it.
+void RS232Bridge::newConnectionSlot()
+{
+	QLocalSocket *socket = this->server.nextPendingConnection();
+
+	if(socket == nullptr)
+	{
+		return;
+	}
+
+	if(this->socket)
+	{
+		this->socket->disconnect(this);
+		this->socket->deleteLater();
+	}
+
+	this->socket = socket;
+	this->input.clear();
+
+	QObject::connect(this->socket.data(), SIGNAL(readyRead()), this, SLOT(readSlot()));
+	QObject::connect(this->socket.data(), SIGNAL(disconnected()), this, SLOT(disconnectedSlot()));
+
+	this->readSlot();
+}
+
+//! Process the end of the connection with the host program
+void RS232Bridge::disconnectedSlot()
+{
+	if(this->socket)
+	{
+		this->socket->deleteLater();
+	}
+
+	this->socket = nullptr;
+}
+
+/**
+ * Read bytes from the host program
+ *
+ * @param size Maximum quantity of bytes
+ *
+ * @return Read bytes, empty when nothing is waiting
+ */
+QByteArray RS232Bridge::readHost(int size)
+{
+	if(this->socket)
+	{
+		return(this->socket->read(size));
+	}
+
+#ifdef Q_OS_UNIX
+	if(this->ptyFd >= 0)
+	{
+		char buffer[READ_SIZE];
+		ssize_t read = ::read(this->ptyFd, buffer, static_cast<size_t>(qMin(size, READ_SIZE)));
+
+		if(read > 0)
+		{
+			return(QByteArray(buffer, static_cast<int>(read)));
+		}
+	}
+#endif
+
+	return(QByteArray());
+}
+
+/**
+ * Read data from the host while the receive ring of the RS232 has space. When it is full, the rest stays in the host buffers,
+ * so the host program is blocked by its own flow control until the CPU reads the ring. It is called again by the receive free signal.
+ */
+void RS232Bridge::readSlot()
+{
+	// Bytes left from the last time go first
+	if(!this->input.isEmpty())
+	{
+		this->input.remove(0, this->io->rs232ReceiveRaw(this->input));
+	}
+
+	while(this->input.isEmpty() && (this->io->rs232GetReceiveFree() > 0))
+	{
+		QByteArray data = this->readHost(qMin(this->io->rs232GetReceiveFree(), READ_SIZE));
+
+		if(data.isEmpty())
+		{
+			break;
+		}
+
+		data.remove(0, this->io->rs232ReceiveRaw(data));
+
+		this->input = data;
+	}
+
+	// The notifier would fire again at once while the data waits for space in the ring
+	if(this->ptyReadNotifier)
+	{
+		this->ptyReadNotifier->setEnabled(this->input.isEmpty() && (this->io->rs232GetReceiveFree() > 0));
+	}
+}
+
+//! Process space in the pseudo-terminal for the waiting transmitted bytes
+void RS232Bridge::ptyWriteSlot()
+{
+	this->writePty();
+}
+
+/**
+ * Send the transmitted bytes to the host. Zero ends a line, so it is sent as a line feed.
+ *
+ * @param data Transmitted bytes
+ */
+void RS232Bridge::transmitSlot(const QByteArray &data)
+{
+	QByteArray out = data;
+
+	out.replace('\0', '\n');
+
+	if(this->socket)
+	{
+		if(this->socket->bytesToWrite() < WRITE_BUFFER_SIZE)
+		{
+			this->socket->write(out);
+		}
+	}
+	else if(this->ptyFd >= 0)
+	{
+		this->ptyPending.append(out);
+
+		if(this->ptyPending.size() > WRITE_BUFFER_SIZE)
+		{
+			this->ptyPending.remove(0, (this->ptyPending.size() - WRITE_BUFFER_SIZE));
+		}
+
+		this->writePty();
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef RS232BRIDGE_H
+#define RS232BRIDGE_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSocketNotifier>
+#include <QPointer>
+#include <QScopedPointer>
+
+#include "io.h"
+
+//! This class contains a bridge of the emulated RS232 to a host pseudo-terminal or a local socket. Data moves in bulk and the receive side follows the free space of the RS232 receive ring.
+class RS232Bridge : public QObject
+{
+	Q_OBJECT
+
+	public:
+		static const int READ_SIZE = 4096; //!< Maximum quantity of bytes read from the host at once
+		static const int WRITE_BUFFER_SIZE = (1 << 20); //!< Maximum quantity of transmitted bytes waiting for the host, older bytes are dropped when it is not read
+
+		RS232Bridge(IO *io, QObject *parent = nullptr);
+		~RS232Bridge() override;
+
+		RS232Bridge(const RS232Bridge &) = delete;
+		RS232Bridge &operator=(const RS232Bridge &) = delete;
+		RS232Bridge(RS232Bridge &&) = delete;
+		RS232Bridge &operator=(RS232Bridge &&) = delete;
+
+		bool listen(const QString &path);
+		bool openPty();
+
+		QString getPath() const;
+
+	private:
+		IO *io; //!< IO with the bridged RS232
+		QString path; //!< Path of the socket or the pseudo-terminal
+
+		QLocalServer server; //!< Server waiting for the host program
+		QPointer<QLocalSocket> socket; //!< Connection with the host program
+
+		int ptyFd; //!< Master side of the pseudo-terminal, -1 when it is not open
+		int ptySlaveFd; //!< Slave side of the pseudo-terminal kept open by the bridge, -1 when it is not open
+		QScopedPointer<QSocketNotifier> ptyReadNotifier; //!< Notifier of data to read from the pseudo-terminal
+		QScopedPointer<QSocketNotifier> ptyWriteNotifier; //!< Notifier of space to write to the pseudo-terminal
+		QByteArray ptyPending; //!< Transmitted bytes waiting for space in the pseudo-terminal
+
+		QByteArray input; //!< Bytes read from the host but not yet taken by the full receive ring
+
+		void closePty();
+		void writePty();
+
+		QByteArray readHost(int size);
+
+	private slots:
+		void newConnectionSlot();
+		void disconnectedSlot();
+		void readSlot();
+		void ptyWriteSlot();
+		void transmitSlot(const QByteArray &data);
+};
+
+#endif
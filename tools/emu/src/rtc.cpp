@@ -14,57 +14,161 @@
 //! Constructor for Real Time Clock functions
 RTC::RTC(QObject *parent) : QObject(parent)
 {
+	this->mode = Mode::Emulated;
+	this->epoch = QDateTime(QDate(2000, 1, 1), QTime(0, 0, 0), Qt::UTC);
+	this->ticksPerSecond = 0;
+
 	this->reset();
 }
 
-//! Reset RTC to default values
+//! Reset RTC to default values. The emulated mode starts from the epoch at the first tick, the wall mode shows the host time.
 void RTC::reset()
 {
-	this->dateTime.setTime(QTime(0, 0, 0));
-	this->dateTime.setDate(QDate(2000, 1, 1));
+	this->baseDateTime = this->epoch;
+	this->baseTicks = 0;
+	this->wallOffset = 0;
+}
+
+/**
+ * Set the source of the time
+ *
+ * @param mode Source of the time
+ */
+void RTC::setMode(RTC::Mode mode)
+{
+	this->mode = mode;
+}
+
+/**
+ * Set the date and time of the emulated mode after a reset
+ *
+ * @param epoch Date and time, only the fields are used
+ */
+void RTC::setEpoch(const QDateTime &epoch)
+{
+	this->epoch = QDateTime(epoch.date(), epoch.time(), Qt::UTC);
+
+	this->reset();
+}
+
+/**
+ * Set the CPU clock frequency used to count seconds in the emulated mode
+ *
+ * @param ticksPerSecond CPU clock ticks per second
+ */
+void RTC::setTicksPerSecond(unsigned long long ticksPerSecond)
+{
+	this->ticksPerSecond = ticksPerSecond;
+}
+
+/**
+ * Get the host wall time as the fields of the local time
+ *
+ * @return Date and time
+ */
+QDateTime RTC::getHostDateTime()
+{
+	const QDateTime now = QDateTime::currentDateTime();
+
+	return(QDateTime(now.date(), now.time(), Qt::UTC));
 }
 
 /**
  * Set date and time
  *
- * @param dateTime Date and time to set in Qt format
+ * @param dateTime Date and time to set in Qt format, only the fields are used
+ * @param ticks Current CPU clock ticks
  */
-void RTC::setDateTime(const QDateTime &dateTime)
+void RTC::setDateTime(const QDateTime &dateTime, unsigned long long ticks)
 {
-	this->dateTime = dateTime;
+	this->baseDateTime = QDateTime(dateTime.date(), dateTime.time(), Qt::UTC);
+	this->baseTicks = ticks;
+	this->wallOffset = getHostDateTime().msecsTo(this->baseDateTime);
 
-	emit updateDateTimeSignal(this->dateTime);
+	emit updateDateTimeSignal(this->baseDateTime);
 }
 
 /**
  * Set date and time
  *
  * @param dateTime Date and time to set in own RTC format
+ * @param ticks Current CPU clock ticks
  */
-void RTC::setDateTime(const RTC::DateTime &dateTime)
+void RTC::setDateTime(const RTC::DateTime &dateTime, unsigned long long ticks)
 {
-	this->dateTime.setTime(QTime(dateTime.hour, dateTime.minute, dateTime.second));
-	this->dateTime.setDate(QDate((static_cast<int>(dateTime.year) + 2000), dateTime.month, dateTime.day));
+	this->setDateTime(QDateTime(QDate((static_cast<int>(dateTime.year) + 2000), dateTime.month, dateTime.day), QTime(dateTime.hour, dateTime.minute, dateTime.second), Qt::UTC), ticks);
+}
 
-	emit updateDateTimeSignal(this->dateTime);
+/**
+ * Get current date and time
+ *
+ * @param ticks Current CPU clock ticks
+ *
+ * @return Date and time in Qt format
+ */
+QDateTime RTC::getCurrent(unsigned long long ticks) const
+{
+	if(this->mode == Mode::Wall)
+	{
+		return(getHostDateTime().addMSecs(this->wallOffset));
+	}
+
+	if((this->ticksPerSecond == 0) || (ticks < this->baseTicks))
+	{
+		return(this->baseDateTime);
+	}
+
+	return(this->baseDateTime.addSecs(static_cast<qint64>((ticks - this->baseTicks) / this->ticksPerSecond)));
 }
 
 /**
- * Get date and time
+ * Get current date and time
+ *
+ * @param ticks Current CPU clock ticks
  *
  * @return Date and time in own RTC format
  */
-RTC::DateTime RTC::getDateTime()
+RTC::DateTime RTC::getDateTime(unsigned long long ticks) const
 {
+	const QDateTime current = this->getCurrent(ticks);
+
 	RTC::DateTime dateTime = {};
 
-	dateTime.year = static_cast<unsigned char>(this->dateTime.date().year() % 100);
-	dateTime.month = static_cast<unsigned char>(this->dateTime.date().month());
-	dateTime.day = static_cast<unsigned char>(this->dateTime.date().day());
+	dateTime.year = static_cast<unsigned char>(current.date().year() % 100);
+	dateTime.month = static_cast<unsigned char>(current.date().month());
+	dateTime.day = static_cast<unsigned char>(current.date().day());
 
-	dateTime.hour = static_cast<unsigned char>(this->dateTime.time().hour());
-	dateTime.minute = static_cast<unsigned char>(this->dateTime.time().minute());
-	dateTime.second = static_cast<unsigned char>(this->dateTime.time().second());
+	dateTime.hour = static_cast<unsigned char>(current.time().hour());
+	dateTime.minute = static_cast<unsigned char>(current.time().minute());
+	dateTime.second = static_cast<unsigned char>(current.time().second());
 
 	return(dateTime);
 }
+
+/**
+ * Save the set date and time to the state stream. Both modes are saved, so the state can be loaded in any mode.
+ *
+ * @param stream State stream
+ */
+void RTC::saveState(QDataStream &stream) const
+{
+	stream << this->baseDateTime << this->baseTicks << this->wallOffset;
+}
+
+/**
+ * Load the set date and time from the state stream
+ *
+ * @param stream State stream
+ */
+void RTC::loadState(QDataStream &stream)
+{
+	stream >> this->baseDateTime >> this->baseTicks >> this->wallOffset;
+
+	// A clock not set since the reset starts from the current epoch, so a snapshot taken with another epoch gives the same time as a cold boot
+	if(this->baseTicks == 0)
+	{
+		this->baseDateTime = this->epoch;
+	}
+
+	emit updateDateTimeSignal(this->baseDateTime);
+}
@@ -14,13 +14,22 @@
 
 #include <QObject>
 #include <QDateTime>
+#include <QDataStream>
 
-//! This class contains Real Time Clock functions
+//! This class contains Real Time Clock functions. The clock follows the host wall time or the emulated time of the CPU clock.
+//! Date and time are kept with the UTC specification but mean the local time of the guest, so no time zone or daylight saving change moves them.
 class RTC : public QObject
 {
 	Q_OBJECT
 
 	public:
+		//! Source of the time
+		enum class Mode
+		{
+			Emulated, //!< Seconds follow the ticks of the CPU clock from the set date and time, runs are reproducible
+			Wall //!< Host wall time moved by the offset of the set date and time
+		};
+
 		//! Fields used by RTC to describe date and time
 		struct DateTime
 		{
@@ -36,13 +45,29 @@ class RTC : public QObject
 
 		void reset();
 
-		void setDateTime(const QDateTime &dateTime);
-		void setDateTime(const RTC::DateTime &dateTime);
+		void saveState(QDataStream &stream) const;
+		void loadState(QDataStream &stream);
+
+		void setMode(RTC::Mode mode);
+		void setEpoch(const QDateTime &epoch);
+		void setTicksPerSecond(unsigned long long ticksPerSecond);
 
-		RTC::DateTime getDateTime();
+		void setDateTime(const QDateTime &dateTime, unsigned long long ticks);
+		void setDateTime(const RTC::DateTime &dateTime, unsigned long long ticks);
+
+		QDateTime getCurrent(unsigned long long ticks) const;
+		RTC::DateTime getDateTime(unsigned long long ticks) const;
 
 	private:
-		QDateTime dateTime; //!< Current date and time
+		Mode mode; //!< Source of the time
+		QDateTime epoch; //!< Date and time in the emulated mode after a reset
+		unsigned long long ticksPerSecond; //!< CPU clock ticks per second
+
+		QDateTime baseDateTime; //!< Date and time set at the base tick
+		unsigned long long baseTicks; //!< CPU clock ticks when the date and time was set
+		qint64 wallOffset; //!< Difference in milliseconds between the set date and time and the host wall time
+
+		static QDateTime getHostDateTime();
 
 	signals:
 		void updateDateTimeSignal(QDateTime dateTime);
@@ -0,0 +1,68 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "scheduler.h"
+
+//! Constructor for the scheduler class
+Scheduler::Scheduler()
+{
+	this->reset();
+}
+
+//! Remove all pending events
+void Scheduler::reset()
+{
+	this->events.clear();
+	this->nextTick = NO_EVENT;
+}
+
+/**
+ * Add a new event to the queue
+ *
+ * @param tick Tick of the CPU clock when the event should be executed
+ * @param event Function to call
+ */
+void Scheduler::add(unsigned long long tick, const Scheduler::Event &event)
+{
+	this->events[tick].append(event);
+
+	this->nextTick = qMin(this->nextTick, tick);
+}
+
+/**
+ * Execute all events which are due. Executed events can add new events.
+ *
+ * @param tick Current tick of the CPU clock
+ */
+void Scheduler::process(unsigned long long tick)
+{
+	while((!this->events.isEmpty()) && (this->events.firstKey() <= tick))
+	{
+		QList<Scheduler::Event> dueEvents = this->events.take(this->events.firstKey());
+
+		for(const Scheduler::Event &event : dueEvents)
+		{
+			event();
+		}
+	}
+
+	this->nextTick = (this->events.isEmpty() ? NO_EVENT : this->events.firstKey());
+}
+
+/**
+ * Get tick of the nearest pending event
+ *
+ * @return Tick of the nearest event or NO_EVENT if the queue is empty
+ */
+unsigned long long Scheduler::getNextTick() const
+{
+	return(this->nextTick);
+}
@@ -0,0 +1,43 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <QMap>
+#include <QList>
+
+#include <functional>
+#include <limits>
+
+//! This class contains a queue of events executed when the CPU clock reaches a given tick
+class Scheduler
+{
+	public:
+		typedef std::function<void()> Event; //!< Function called when the event is due
+
+		static const unsigned long long NO_EVENT = std::numeric_limits<unsigned long long>::max(); //!< Next tick value when the queue is empty
+
+		Scheduler();
+
+		void reset();
+
+		void add(unsigned long long tick, const Scheduler::Event &event);
+		void process(unsigned long long tick);
+
+		unsigned long long getNextTick() const;
+
+	private:
+		QMap<unsigned long long, QList<Scheduler::Event>> events; //!< Pending events grouped by the tick. Events of the same tick are kept in the adding order.
+		unsigned long long nextTick; //!< Tick of the nearest pending event
+};
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "snapshotcache.h"
+
+//! Constructor for the snapshot cache class
+SnapshotCache::SnapshotCache()
+{
+	this->path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation).append("/snapshot");
+}
+
+/**
+ * Create a key of the snapshot. It is a SHA-256 hash of both uROMs, the BIOS, the OS file and a manifest of the file system directory.
+ *
+ * @param urom0 First uROM data
+ * @param urom1 Second uROM data
+ * @param bios BIOS data
+ * @param fsPath Path to the emulated file system on the local disk
+ *
+ * @return Key of the snapshot
+ */
+QByteArray SnapshotCache::createKey(const CPU::UROM &urom0, const CPU::UROM &urom1, const CPU::BIOS &bios, const QString &fsPath)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+
+	hash.addData(QByteArray::number(VERSION));
+
+	hash.addData(reinterpret_cast<const char *>(urom0.data.constData()), urom0.data.size());
+	hash.addData(reinterpret_cast<const char *>(urom1.data.constData()), urom1.data.size());
+	hash.addData(reinterpret_cast<const char *>(bios.data.constData()), bios.data.size());
+
+	QFile osFile(QString(fsPath).append("/os.bin"));
+
+	if(osFile.open(QIODevice::ReadOnly))
+	{
+		hash.addData(&osFile);
+
+		osFile.close();
+	}
+
+	// The manifest contains a path, a size and a modification time of every file
+	QDir fsDir(fsPath);
+	QStringList manifest;
+	QDirIterator it(fsPath, QDir::Files, QDirIterator::Subdirectories);
+
+	while(it.hasNext())
+	{
+		it.next();
+
+		QFileInfo fileInfo = it.fileInfo();
+
+		manifest.append(QString("%1:%2:%3").arg(fsDir.relativeFilePath(fileInfo.filePath())).arg(fileInfo.size()).arg(fileInfo.lastModified().toMSecsSinceEpoch()));
+	}
+
+	manifest.sort();
+
+	hash.addData(manifest.join("\n").toUtf8());
+
+	return(hash.result());
+}
+
+/**
+ * Load a state from the cache
+ *
+ * @param key Key of the snapshot
+ * @param state Buffer where the state will be written
+ *
+ * @return Status of loading the state
+ */
+bool SnapshotCache::load(const QByteArray &key, QByteArray &state) const
+{
+	QFile file(this->getFilePath(key));
+
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		return(false);
+	}
+
+	state = file.readAll();
+
+	file.close();
+
+	return(!state.isEmpty());
+}
+
+/**
+ * Save a state to the cache
+ *
+ * @param key Key of the snapshot
+ * @param state State to save
+ *
+ * @return Status of saving the state
+ */
+bool SnapshotCache::save(const QByteArray &key, const QByteArray &state) const
+{
+	if(!QDir().mkpath(this->path))
+	{
+		return(false);
+	}
+
+	QSaveFile file(this->getFilePath(key));
+
+	if(!file.open(QIODevice::WriteOnly))
+	{
+		return(false);
+	}
+
+	if(file.write(state) != state.size())
+	{
+		file.cancelWriting();
+
+		return(false);
+	}
+
+	return(file.commit());
+}
+
+/**
+ * Remove a state from the cache
+ *
+ * @param key Key of the snapshot
+ */
+void SnapshotCache::remove(const QByteArray &key) const
+{
+	QFile::remove(this->getFilePath(key));
+}
+
+/**
+ * Get path to the file of the snapshot
+ *
+ * @param key Key of the snapshot
+ *
+ * @return Path to the file
+ */
+QString SnapshotCache::getFilePath(const QByteArray &key) const
+{
+	return(QString(this->path).append("/").append(QString::fromLatin1(key.toHex())).append(".state"));
+}
@@ -0,0 +1,48 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef SNAPSHOTCACHE_H
+#define SNAPSHOTCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringList>
+
+#include "cpu.h"
+
+//! This class contains a disk cache of the machine states taken when the OS reaches its idle prompt
+class SnapshotCache
+{
+	public:
+		static const int VERSION = 8; //!< Version of the snapshot format. It is a part of the key, so a new format never loads old snapshots.
+
+		SnapshotCache();
+
+		static QByteArray createKey(const CPU::UROM &urom0, const CPU::UROM &urom1, const CPU::BIOS &bios, const QString &fsPath);
+
+		bool load(const QByteArray &key, QByteArray &state) const;
+		bool save(const QByteArray &key, const QByteArray &state) const;
+		void remove(const QByteArray &key) const;
+
+	private:
+		QString path; //!< Path to the cache directory
+
+		QString getFilePath(const QByteArray &key) const;
+};
+
+#endif
@@ -18,17 +18,32 @@
  */
 Speaker::Speaker(QObject *parent) : QObject(parent)
 {
-	this->audioFormat.setSampleRate(SAMPLE_RATE);
-	this->audioFormat.setSampleSize(16);
-	this->audioFormat.setChannelCount(1);
-	this->audioFormat.setCodec("audio/pcm");
-	this->audioFormat.setByteOrder(QAudioFormat::LittleEndian);
-	this->audioFormat.setSampleType(QAudioFormat::SignedInt);
+	for(int i = 0; i < NOTE_QUANTITY; i++)
+	{
+		this->notePhaseStep[i] = static_cast<quint32>((static_cast<quint64>(this->noteFrequency[i]) << 32) / SAMPLE_RATE);
+	}
+
+	for(int i = 0; i < FILL_QUANTITY; i++)
+	{
+		this->fillPhase[i] = static_cast<quint32>((static_cast<quint64>(i) << 32) / FILL_QUANTITY);
+	}
+
+	this->bandLimited = false;
+
+	this->scheduler = nullptr;
+	this->ticksPerMs = 0;
+	this->generation = 0;
+
+	this->deviceEnabled = true;
+	this->wavStarted = false;
+	this->wavStartTick = 0;
 
-	this->audioOutput.reset(new QAudioOutput(this->audioFormat, this));
-	this->audioOutput->setNotifyInterval(50);
+	// The audio thread is started with the first note, so the audio device is not opened when nothing is played or the device is disabled
+	this->audioOutput = new AudioOutput(&this->ring, SAMPLE_RATE);
+	this->audioOutput->moveToThread(&this->audioThread);
 
-	QObject::connect(this->audioOutput.data(), SIGNAL(notify()), this, SLOT(audioNotifySlot()));
+	QObject::connect(&this->audioThread, SIGNAL(started()), this->audioOutput, SLOT(startSlot()));
+	QObject::connect(&this->audioThread, SIGNAL(finished()), this->audioOutput, SLOT(deleteLater()));
 
 	this->reset();
 }
@@ -38,6 +53,16 @@ Speaker::~Speaker()
 {
 	this->reset();
 
+	if(this->audioThread.isRunning())
+	{
+		this->audioThread.quit();
+		this->audioThread.wait();
+	}
+	else
+	{
+		delete this->audioOutput;
+	}
+
 	QObject::disconnect(this);
 }
 
@@ -47,22 +72,49 @@ void Speaker::reset()
 	this->clear();
 }
 
-//! Start playing sound
-void Speaker::play()
+/**
+ * Set the scheduler of the CPU. Notes are played in the emulated time, the next one starts when the CPU clock reaches the end of the current one.
+ *
+ * @param scheduler Scheduler of the CPU
+ * @param ticksPerMs CPU clock ticks per ms
+ */
+void Speaker::setScheduler(Scheduler *scheduler, unsigned int ticksPerMs)
+{
+	this->scheduler = scheduler;
+	this->ticksPerMs = ticksPerMs;
+}
+
+/**
+ * Start playing sound
+ *
+ * @param tick Current tick of the CPU clock
+ */
+void Speaker::play(unsigned long long tick)
 {
 	if((!this->playing) && (!this->buffer.empty()))
 	{
-		this->playNextNote();
+		this->playNextNote(tick);
 	}
 }
 
-//! Pause playing sound
-void Speaker::pause()
+/**
+ * Pause playing sound. The current note is stopped and the next one is played after the next play command.
+ *
+ * @param tick Current tick of the CPU clock, the WAV file is cut at this time
+ */
+void Speaker::pause(unsigned long long tick)
 {
-	if(!this->playing)
+	if(this->playing)
 	{
-	   this->playing = false;
-	   this->audioOutput->stop();
+		this->playing = false;
+		this->generation++;
+
+		this->ring.flush();
+
+		if(this->wavStarted)
+		{
+			this->wav.truncate(this->getWavPosition(tick));
+		}
 	}
 }
 
@@ -70,14 +122,10 @@ void Speaker::pause()
 void Speaker::clear()
 {
 	this->playing = false;
+	this->generation++;
 
-	this->audioOutput->reset();
 	this->buffer.clear();
-
-	this->bufferOut.clear();
-	this->audioOutput->stop();
-
-	this->ioDevice = this->audioOutput->start();
+	this->ring.flush();
 }
 
 /**
@@ -99,8 +147,64 @@ void Speaker::setVolume(unsigned int volume)
 {
 	if(volume <= 100)
 	{
-		this->audioOutput->setVolume(static_cast<qreal>(volume) / 100.0);
+		QMetaObject::invokeMethod(this->audioOutput, "setVolumeSlot", Qt::QueuedConnection, Q_ARG(qreal, (static_cast<qreal>(volume) / 100.0)));
+	}
+}
+
+/**
+ * Set smoothing of the square wave edges. It removes the aliasing of high notes at the cost of a slower synthesis.
+ *
+ * @param enable Enable status
+ */
+void Speaker::setBandLimited(bool enable)
+{
+	this->bandLimited = enable;
+}
+
+/**
+ * Set playing samples on the audio device. When it is disabled, notes only advance in the emulated time and the audio device is never opened.
+ *
+ * @param enable Enable status
+ */
+void Speaker::setDeviceEnabled(bool enable)
+{
+	this->deviceEnabled = enable;
+
+	if(!enable)
+	{
+		this->ring.flush();
+	}
+}
+
+/**
+ * Set the WAV file for the played samples. Gaps between notes are written as silence according to the emulated time.
+ *
+ * @param path Path to the WAV file
+ *
+ * @return Status of creating the file
+ */
+bool Speaker::setWavPath(const QString &path)
+{
+	this->wavStarted = false;
+
+	return(this->wav.open(path, SAMPLE_RATE));
+}
+
+/**
+ * Get the position in the WAV file for the tick of the CPU clock
+ *
+ * @param tick Tick of the CPU clock
+ *
+ * @return Quantity of samples since the first note
+ */
+qint64 Speaker::getWavPosition(unsigned long long tick) const
+{
+	if((this->ticksPerMs == 0) || (tick < this->wavStartTick))
+	{
+		return(this->wav.getSamples());
 	}
+
+	return(static_cast<qint64>(((tick - this->wavStartTick) * SAMPLE_RATE) / (this->ticksPerMs * 1000ULL)));
 }
 
 /**
@@ -167,8 +271,12 @@ unsigned char Speaker::getBufferFree()
 	return(static_cast<unsigned char>(BUFFER_SIZE - this->buffer.length()));
 }
 
-//! Load next note to play from the buffer
-void Speaker::playNextNote()
+/**
+ * Load next note to play from the buffer and write its samples to the audio ring
+ *
+ * @param tick Tick of the CPU clock when the note starts
+ */
+void Speaker::playNextNote(unsigned long long tick)
 {
 	if(!this->buffer.empty())
 	{
@@ -176,78 +284,150 @@ void Speaker::playNextNote()
 
 		char signalLevel = static_cast<char>(VALUE_MUL * VALUE_VOLUME * (static_cast<double>(noteItem.volume) / VOLUME_MAX));
 
-		char high = ((noteItem.note == NoteCode::NOTE_SILENT) ? 0 : signalLevel);
-		char low = 0;
+		// The level is the high byte of the 16 bit sample
+		int level = (((noteItem.note == NoteCode::NOTE_SILENT) ? 0 : signalLevel) << 8);
+		int samples = (noteItem.time * SAMPLES_PER_TIME);
 
-		double duration = (static_cast<double>(noteItem.time) * TIME_MUL);
-		double fill = (static_cast<double>(noteItem.fill) / FILL_DIV);
+		qint16 *out = this->noteSamples.data();
+		quint32 step = this->notePhaseStep[noteItem.note];
+		quint32 fall = this->fillPhase[noteItem.fill];
 
-		double atomicTime = (1000.0 / SAMPLE_RATE);
-		double sqareTime = (1000.0 / static_cast<double>(noteFrequency[static_cast<int>(noteItem.note)]));
-		double time = 0.0;
-
-		QByteArray data;
-
-		for(double i = 0.0; i < (duration - 0.01); i += atomicTime)
+		if(this->bandLimited && (level != 0))
+		{
+			this->synthesizeBandLimited(out, samples, step, fall, level);
+		}
+		else
 		{
-			data.append(static_cast<char>(0));
-			data.append((time < (sqareTime * fill)) ? high : low);
+			this->synthesize(out, samples, step, fall, level);
+		}
 
-			if(time >= sqareTime)
+		if(this->wav.isOpen())
+		{
+			if(!this->wavStarted)
 			{
-				time = 0.0;
+				this->wavStarted = true;
+				this->wavStartTick = tick;
 			}
-			else
+
+			this->wav.writeSilence(this->getWavPosition(tick) - this->wav.getSamples());
+			this->wav.write(out, samples);
+		}
+
+		if(this->deviceEnabled)
+		{
+			if(!this->audioThread.isRunning())
 			{
-				time += atomicTime;
+				this->audioThread.start(QThread::TimeCriticalPriority);
 			}
+
+			// When the emulation is faster than the audio device, the rest of the note is dropped
+			this->ring.write(out, samples);
 		}
 
-		this->bufferOut.append(data);
+		this->playing = true;
 
 		emit updateStatusSignal(this->buffer.length());
 
-		if(!this->playing)
+		if(this->scheduler != nullptr)
 		{
-			this->playing = true;
+			unsigned long long end = (tick + (static_cast<unsigned long long>(noteItem.time) * static_cast<unsigned long long>(TIME_MUL) * this->ticksPerMs));
+			unsigned int generation = this->generation;
 
-			this->audioNotifySlot();
+			this->scheduler->add(end, [this, end, generation]()
+			{
+				if(generation == this->generation)
+				{
+					this->playNextNote(end);
+				}
+			});
+		}
+		else
+		{
+			// Without the emulated time all notes are written at once
+			this->playNextNote(tick);
 		}
 	}
 	else
 	{
 		this->playing = false;
+
+		emit updateStatusSignal(this->buffer.length());
 	}
 }
 
-//! Load next raw data to play to the audio output
-void Speaker::audioNotifySlot()
+/**
+ * Generate a square wave using a fixed-point phase accumulator. Overflow of the phase starts the next period.
+ *
+ * @param out Output buffer for the samples
+ * @param samples Quantity of samples to generate
+ * @param step Phase increment per sample
+ * @param fall Phase of the falling edge
+ * @param level Sample value of the high state
+ */
+void Speaker::synthesize(qint16 *out, int samples, quint32 step, quint32 fall, int level) const
 {
-	if(this->playing)
+	const qint16 high = static_cast<qint16>(level);
+	const qint16 low = 0;
+
+	quint32 phase = 0;
+
+	for(int i = 0; i < samples; i++)
 	{
-		int freeBytes = this->audioOutput->bytesFree();
+		out[i] = ((phase < fall) ? high : low);
+		phase += step;
+	}
+}
 
-		if(freeBytes > 0)
-		{
-			int bufferBytes = this->bufferOut.length();
-			int bytesToWrite = qMin(bufferBytes, freeBytes);
+/**
+ * Generate a square wave with the edges smoothed by the polynomial band-limited step
+ *
+ * @param out Output buffer for the samples
+ * @param samples Quantity of samples to generate
+ * @param step Phase increment per sample
+ * @param fall Phase of the falling edge
+ * @param level Sample value of the high state
+ */
+void Speaker::synthesizeBandLimited(qint16 *out, int samples, quint32 step, quint32 fall, int level) const
+{
+	const double scale = (1.0 / 4294967296.0);
+	const double dt = (step * scale);
+	const double edge = (level * 0.5);
 
-			if(bufferBytes > 0)
-			{
-				this->ioDevice->write(this->bufferOut.left(bytesToWrite));
-				this->bufferOut.remove(0, bytesToWrite);
+	quint32 phase = 0;
 
-				if(freeBytes > bytesToWrite)
-				{
-					this->playNextNote();
-					this->audioNotifySlot();
-				}
-			}
-			else
-			{
-				this->playNextNote();
-				this->audioNotifySlot();
-			}
-		}
+	for(int i = 0; i < samples; i++)
+	{
+		double value = ((phase < fall) ? level : 0);
+
+		value += (edge * polyBlep(phase * scale, dt));
+		value -= (edge * polyBlep(static_cast<quint32>(phase - fall) * scale, dt));
+
+		out[i] = static_cast<qint16>(qBound(-32768, qRound(value), 32767));
+		phase += step;
 	}
 }
+
+/**
+ * Get the correction of a unit step near an edge of the wave
+ *
+ * @param t Phase since the edge in range 0-1
+ * @param dt Phase increment per sample
+ *
+ * @return Correction in range -1 to 1
+ */
+double Speaker::polyBlep(double t, double dt)
+{
+	if(t < dt)
+	{
+		t /= dt;
+		return((t + t) - (t * t) - 1.0);
+	}
+
+	if(t > (1.0 - dt))
+	{
+		t = ((t - 1.0) / dt);
+		return((t * t) + (t + t) + 1.0);
+	}
+
+	return(0.0);
+}
@@ -14,10 +14,13 @@
 
 #include <QObject>
 #include <QList>
-#include <QAudioFormat>
-#include <QAudioOutput>
-#include <QByteArray>
-#include <QScopedPointer>
+#include <QVector>
+#include <QThread>
+
+#include "audioring.h"
+#include "audiooutput.h"
+#include "scheduler.h"
+#include "wavwriter.h"
 
 //! This class contains speaker functions
 class Speaker : public QObject
@@ -46,6 +49,9 @@ class Speaker : public QObject
 		static constexpr double VALUE_MUL = 127.0; //!< Output level multiplicator used to conversion
 		static constexpr double VALUE_VOLUME = 0.3; //!< Output volume level multiplicator
 
+		static const int SAMPLES_PER_TIME = static_cast<int>((TIME_MUL * SAMPLE_RATE) / 1000); //!< Quantity of samples generated for one unit of the note time
+		static const int FILL_QUANTITY = 16; //!< Quantity of the square wave fill levels
+
 		//! Fields used by speaker to describe note
 		struct Note
 		{
@@ -65,12 +71,17 @@ class Speaker : public QObject
 
 		void reset();
 
-		void play();
-		void pause();
+		void setScheduler(Scheduler *scheduler, unsigned int ticksPerMs);
+
+		void play(unsigned long long tick);
+		void pause(unsigned long long tick);
 		void clear();
 		bool isPlaying();
 
 		void setVolume(unsigned int volume);
+		void setBandLimited(bool enable);
+		void setDeviceEnabled(bool enable);
+		bool setWavPath(const QString &path);
 
 		void addNote(const Speaker::Note &note);
 		unsigned char getBufferFree();
@@ -108,19 +119,36 @@ class Speaker : public QObject
 		bool playing; //!< Playing status
 		QList<struct Note> buffer; //!< Buffer of notes
 
-		QAudioFormat audioFormat; //!< Audio stream parameter information
-		QScopedPointer<QAudioOutput> audioOutput; //!< Interface to an audio output device
-		QIODevice *ioDevice; //!< IO device retuned by QAudioOutput
+		Scheduler *scheduler; //!< Scheduler of the CPU used to start the next note after the emulated time of the current one
+		unsigned int ticksPerMs; //!< CPU clock ticks per ms
+		unsigned int generation; //!< Number increased when playing stops, so the pending events of the previous notes are ignored
+
+		AudioRing ring; //!< Samples waiting for the audio thread
+		QThread audioThread; //!< Thread pulling samples to the audio device
+		AudioOutput *audioOutput; //!< Audio output living on the audio thread
+		bool deviceEnabled; //!< Status of playing samples on the audio device, otherwise notes only advance in the emulated time
+
+		WavWriter wav; //!< Writer of the played samples to a WAV file
+		bool wavStarted; //!< Status of the first note written to the WAV file
+		unsigned long long wavStartTick; //!< Tick of the CPU clock when the first note written to the WAV file started
 
-		QByteArray bufferOut; //!< Raw buffer with prepared data ready to send to IO device
+		QVector<qint16> noteSamples = QVector<qint16>(TIME_MAX * SAMPLES_PER_TIME); //!< Samples of the current note
 
-		void playNextNote();
+		QVector<quint32> notePhaseStep = QVector<quint32>(NOTE_QUANTITY); //!< Phase increment per sample for every note, full period is 2^32
+		QVector<quint32> fillPhase = QVector<quint32>(FILL_QUANTITY); //!< Phase of the falling edge for every square wave fill
+
+		bool bandLimited; //!< Status of smoothing the edges of the square wave to limit aliasing
+
+		void playNextNote(unsigned long long tick);
+		void synthesize(qint16 *out, int samples, quint32 step, quint32 fall, int level) const;
+		void synthesizeBandLimited(qint16 *out, int samples, quint32 step, quint32 fall, int level) const;
+
+		qint64 getWavPosition(unsigned long long tick) const;
+
+		static double polyBlep(double t, double dt);
 
 	signals:
 		void updateStatusSignal(int bufferUsed);
-
-	private slots:
-		void audioNotifySlot();
 };
 
 #endif
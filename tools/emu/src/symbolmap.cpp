@@ -0,0 +1,76 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include "symbolmap.h"
+
+#include "cpu.h"
+
+//! Constructor for the symbol map class
+SymbolMap::SymbolMap()
+{
+}
+
+//! Remove all symbols
+void SymbolMap::clear()
+{
+	this->symbols.clear();
+}
+
+/**
+ * Add symbols from the map file. Lines have the "external var NAME = 0xADDR", "external const NAME = 0xADDR" or "NAME = 0xADDR" form, other lines are skipped.
+ * A symbol read again replaces the old address.
+ *
+ * @param path Path to the map file
+ *
+ * @return Status of opening the file
+ */
+bool SymbolMap::load(const QString &path)
+{
+	QFile file(path);
+
+	if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return(false);
+	}
+
+	const QRegularExpression regExp("^\\s*(?:external\\s+(?:var|const)\\s+)?([0-9a-zA-Z_.-]+)\\s*=\\s*0x([0-9a-fA-F]+)\\s*$", QRegularExpression::CaseInsensitiveOption);
+	QTextStream stream(&file);
+
+	while(!stream.atEnd())
+	{
+		QRegularExpressionMatch match = regExp.match(stream.readLine());
+
+		if(match.hasMatch())
+		{
+			bool ok;
+			int address = match.captured(2).toInt(&ok, 16);
+
+			if(ok && (address < CPU::MEMORY_SIZE))
+			{
+				this->symbols.insert(match.captured(1), address);
+			}
+		}
+	}
+
+	file.close();
+
+	return(true);
+}
+
+/**
+ * Get all symbols
+ *
+ * @return Addresses of symbols by name
+ */
+const QMap<QString, int> &SymbolMap::getSymbols() const
+{
+	return(this->symbols);
+}
@@ -0,0 +1,36 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef SYMBOLMAP_H
+#define SYMBOLMAP_H
+
+#include <QString>
+#include <QMap>
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+
+//! This class contains addresses of symbols read from the map files written by the assembler
+class SymbolMap
+{
+	public:
+		SymbolMap();
+
+		void clear();
+		bool load(const QString &path);
+
+		const QMap<QString, int> &getSymbols() const;
+
+	private:
+		QMap<QString, int> symbols; //!< Addresses of symbols by name
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#include <algorithm>
+
+#include "wavwriter.h"
+
+//! Constructor for the WAV writer class
+WavWriter::WavWriter()
+{
+	this->sampleRate = 0;
+	this->samples = 0;
+}
+
+//! Destructor for the WAV writer class. It completes the header of the open file.
+WavWriter::~WavWriter()
+{
+	this->close();
+}
+
+/**
+ * Create the WAV file
+ *
+ * @param path Path to the file
+ * @param sampleRate Sample rate in Hz
+ *
+ * @return Status of creating the file
+ */
+bool WavWriter::open(const QString &path, int sampleRate)
+{
+	this->close();
+
+	this->file.setFileName(path);
+
+	if(!this->file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		return(false);
+	}
+
+	this->sampleRate = sampleRate;
+	this->samples = 0;
+
+	this->writeHeader();
+
+	return(true);
+}
+
+//! Complete the header with the final sizes and close the file
+void WavWriter::close()
+{
+	if(this->file.isOpen())
+	{
+		this->writeHeader();
+		this->file.close();
+	}
+}
+
+/**
+ * Check if the file is open
+ *
+ * @return Status of the open file
+ */
+bool WavWriter::isOpen() const
+{
+	return(this->file.isOpen());
+}
+
+/**
+ * Append samples to the file
+ *
+ * @param samples Samples in the host byte order
+ * @param count Quantity of samples
+ */
+void WavWriter::write(const qint16 *samples, int count)
+{
+	if((!this->file.isOpen()) || (count <= 0))
+	{
+		return;
+	}
+
+	if(QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+	{
+		this->file.write(reinterpret_cast<const char *>(samples), (static_cast<qint64>(count) * SAMPLE_BYTES));
+	}
+	else
+	{
+		QVector<qint16> data(count);
+
+		for(int i = 0; i < count; i++)
+		{
+			data[i] = qToLittleEndian(samples[i]);
+		}
+
+		this->file.write(reinterpret_cast<const char *>(data.constData()), (static_cast<qint64>(count) * SAMPLE_BYTES));
+	}
+
+	this->samples += count;
+}
+
+/**
+ * Append silence to the file
+ *
+ * @param count Quantity of samples
+ */
+void WavWriter::writeSilence(qint64 count)
+{
+	if((!this->file.isOpen()) || (count <= 0))
+	{
+		return;
+	}
+
+	this->file.write(QByteArray(static_cast<int>(count * SAMPLE_BYTES), 0));
+
+	this->samples += count;
+}
+
+/**
+ * Remove samples from the end of the file
+ *
+ * @param count Quantity of samples to keep
+ */
+void WavWriter::truncate(qint64 count)
+{
+	if((!this->file.isOpen()) || (count < 0) || (count >= this->samples))
+	{
+		return;
+	}
+
+	this->file.resize(HEADER_SIZE + (count * SAMPLE_BYTES));
+	this->file.seek(HEADER_SIZE + (count * SAMPLE_BYTES));
+
+	this->samples = count;
+}
+
+/**
+ * Get quantity of written samples
+ *
+ * @return Quantity of samples
+ */
+qint64 WavWriter::getSamples() const
+{
+	return(this->samples);
+}
+
+//! Write the RIFF header with the current sizes at the beginning of the file
+void WavWriter::writeHeader()
+{
+	const quint32 dataSize = static_cast<quint32>(this->samples * SAMPLE_BYTES);
+
+	QByteArray header(HEADER_SIZE, 0);
+	uchar *data = reinterpret_cast<uchar *>(header.data());
+
+	std::copy_n("RIFF", 4, header.data());
+	qToLittleEndian<quint32>((dataSize + HEADER_SIZE - 8), (data + 4));
+	std::copy_n("WAVEfmt ", 8, (header.data() + 8));
+	qToLittleEndian<quint32>(16, (data + 16));
+	qToLittleEndian<quint16>(1, (data + 20));
+	qToLittleEndian<quint16>(1, (data + 22));
+	qToLittleEndian<quint32>(static_cast<quint32>(this->sampleRate), (data + 24));
+	qToLittleEndian<quint32>(static_cast<quint32>(this->sampleRate * SAMPLE_BYTES), (data + 28));
+	qToLittleEndian<quint16>(SAMPLE_BYTES, (data + 32));
+	qToLittleEndian<quint16>(16, (data + 34));
+	std::copy_n("data", 4, (header.data() + 36));
+	qToLittleEndian<quint32>(dataSize, (data + 40));
+
+	const qint64 position = this->file.pos();
+
+	this->file.seek(0);
+	this->file.write(header);
+	this->file.seek(qMax(position, static_cast<qint64>(HEADER_SIZE)));
+}
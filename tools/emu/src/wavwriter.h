@@ -0,0 +1,55 @@
+/*
+ * Author: Pawel Jablonski
+ * E-mail: pj@xirx.net
+ * WWW: xirx.net
+ * GIT: git.xirx.net
+ *
+ * License: You can use this code however you like
+ * but leave information about the original author.
+ * Code is free for non-commercial and commercial use.
+ */
+
+#ifndef WAVWRITER_H
+#define WAVWRITER_H
+
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QtEndian>
+#include <QSysInfo>
+
+//! This class contains a writer of 16 bit mono PCM samples to a WAV file
+class WavWriter
+{
+	public:
+		static const int HEADER_SIZE = 44; //!< Size of the WAV header in bytes
+		static const int SAMPLE_BYTES = 2; //!< Size of one sample in bytes
+
+		WavWriter();
+		~WavWriter();
+
+		WavWriter(const WavWriter &) = delete;
+		WavWriter &operator=(const WavWriter &) = delete;
+		WavWriter(WavWriter &&) = delete;
+		WavWriter &operator=(WavWriter &&) = delete;
+
+		bool open(const QString &path, int sampleRate);
+		void close();
+		bool isOpen() const;
+
+		void write(const qint16 *samples, int count);
+		void writeSilence(qint64 count);
+		void truncate(qint64 count);
+
+		qint64 getSamples() const;
+
+	private:
+		QFile file; //!< WAV file
+		int sampleRate; //!< Sample rate in Hz
+		qint64 samples; //!< Quantity of written samples
+
+		void writeHeader();
+};
+
+#endif